@@ -0,0 +1,63 @@
+#pragma once
+#include "CrcConsts.hpp"
+
+#include <cstdint>
+
+namespace tjg::crc {
+
+/* Reduce a 128-bit fold accumulator to the CRC register, i.e. the value the
+   table kernel reaches after the accumulator's 16 bytes, starting from zero.
+   That is u(x)*x^Bits mod P(x): two folds bring u down below 2*Bits bits and
+   a Barrett step with Mu2N = floor(x^(2*Bits) / P(x)) finishes it.  Every
+   multiply is one carry-less 64x64 product supplied by the caller, so each
+   kernel unit keeps its own instruction set.  */
+
+/// Non-reflected: bit i of u is the coefficient of x^i.
+template<typename C, typename ClMul>
+requires (C::Bits >= 32)
+[[gnu::always_inline]]
+inline std::uint64_t BarrettReduce(unsigned __int128 u, ClMul clmul) noexcept {
+  using uint128_t = unsigned __int128;
+  using std::uint64_t;
+  constexpr int W = C::Bits;
+  constexpr uint64_t K1 = C::XpowMod(64 + W);
+  constexpr uint64_t K2 = C::XpowMod(64);
+  constexpr uint64_t Mu = C::Mu2N & C::Mask;   // x^W term applied below
+
+  auto s = clmul(uint64_t(u >> 64), K1) ^ (uint128_t{uint64_t(u)} << W);
+  if constexpr (W < 64)
+    s = clmul(uint64_t(s >> 64), K2) ^ uint128_t{uint64_t(s)};
+  const auto t = uint64_t(s >> W);
+  const auto q = t ^ uint64_t(clmul(t, Mu) >> W);
+  return uint64_t(s ^ clmul(q, C::Poly)) & C::Mask;
+} // BarrettReduce
+
+/// Reflected: bit i of u is the coefficient of x^(127-i).  The product of two
+/// reflected operands comes out as the reflected product times x, which is
+/// absorbed by taking the fold constants one power lower and by the final
+/// shift of the quotient product.
+template<typename C, typename ClMul>
+requires (C::Bits >= 32)
+[[gnu::always_inline]]
+inline std::uint64_t BarrettReduceReflected(unsigned __int128 u, ClMul clmul)
+  noexcept
+{
+  using uint128_t = unsigned __int128;
+  using std::uint64_t;
+  constexpr int W = C::Bits;
+  constexpr uint64_t K1 = Reflect(C::XpowMod(64 + W - 1), 64);
+  constexpr uint64_t K2 = Reflect(C::XpowMod(63), 64);
+  constexpr uint64_t Mu = Reflect(C::Mu2N & C::Mask, 64);
+  constexpr uint64_t P  = Reflect(C::Poly, 64);
+  constexpr uint128_t High = ~uint128_t{0} << 64;
+
+  auto s = clmul(uint64_t(u), K1) ^ (uint128_t{uint64_t(u >> 64)} << (64-W));
+  if constexpr (W < 64)
+    s = clmul(uint64_t(s), K2) ^ (s & High);
+  const auto t = uint64_t(s >> (64-W));
+  const auto q = t ^ uint64_t((clmul(t, Mu) << 1) >> (64-W));
+  const auto r = uint64_t(s >> (128-W)) ^ uint64_t(clmul(q, P) >> (127-W));
+  return r & C::Mask;
+} // BarrettReduceReflected
+
+} // tjg::crc
@@ -0,0 +1,207 @@
+#include "cksum.hpp"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <array>
+#include <algorithm>
+#include <random>
+#include <charconv>
+#include <stdexcept>
+#include <cerrno>
+#include <cstdint>
+#include <ctime>
+
+#include <sys/stat.h>
+#include <sys/xattr.h>
+
+/* The cached checksum of a file lives in its user.cksum extended attribute
+   as one line of text:
+
+     cksum2 CRC LENGTH MTIME CTIME CTIME_MAX INODE
+
+   with the times as seconds.nanoseconds.  An entry is trusted while the
+   file's inode, length and mtime still match it and its ctime lies between
+   CTIME and CTIME_MAX.  The ctime cannot be matched exactly, because writing
+   the attribute moves it to a time not known in advance, so the entry
+   brackets it: CTIME is the file's ctime when it was read, CTIME_MAX the
+   clock plus StoreSlack just before the attribute was written.  An entry
+   whose own write lands outside that bracket is removed again.  Any later
+   change to the file, a rewrite in place that restores its mtime and size
+   included, moves the ctime past CTIME_MAX, unless it comes within
+   StoreSlack of the entry being written.  */
+
+namespace {
+
+constexpr auto CacheAttr = "user.cksum";
+constexpr auto CacheTag  = std::string_view{"cksum2"};
+
+/* Longest entry Format() can produce: a word of up to 20 characters for
+   every number but the CRC, and 30 for every seconds.nanoseconds time.  */
+constexpr std::size_t MaxEntry = CacheTag.size() + (1 + 10) + (1 + 20)
+                               + 3 * (1 + 20 + 1 + 9) + (1 + 20);
+
+// Longest expected from reading the clock to the attribute's ctime.
+constexpr long StoreSlack = 2'000'000;    // ns
+
+struct CacheEntry {
+  CrcType crc = CrcType{0};
+  std::uintmax_t length = 0;
+  timespec mtime{};
+  timespec ctime{};
+  timespec ctime_max{};
+  std::uintmax_t inode = 0;
+}; // CacheEntry
+
+bool operator==(const timespec& a, const timespec& b) noexcept
+  { return (a.tv_sec == b.tv_sec && a.tv_nsec == b.tv_nsec); }
+
+bool operator<(const timespec& a, const timespec& b) noexcept {
+  return (a.tv_sec < b.tv_sec)
+      || (a.tv_sec == b.tv_sec && a.tv_nsec < b.tv_nsec);
+}
+
+CacheEntry Describe(const struct stat& st) noexcept {
+  auto e = CacheEntry{};
+  e.length = static_cast<std::uintmax_t>(st.st_size);
+  e.mtime  = st.st_mtim;
+  e.ctime  = st.st_ctim;
+  e.ctime_max = st.st_ctim;
+  e.inode  = static_cast<std::uintmax_t>(st.st_ino);
+  return e;
+} // Describe
+
+// Whether the file, as `now` describes it, still holds the data `e` was
+// computed from.
+bool Matches(const CacheEntry& e, const CacheEntry& now) noexcept {
+  return (e.inode == now.inode && e.length == now.length
+       && e.mtime == now.mtime
+       && !(now.ctime < e.ctime) && !(e.ctime_max < now.ctime));
+}
+
+std::string Format(const CacheEntry& e) {
+  auto time = [](const timespec& t) {
+    auto ns = std::to_string(t.tv_nsec);
+    return std::to_string(t.tv_sec) + '.'
+         + std::string(9 - ns.size(), '0') + ns;
+  };
+  return std::string{CacheTag}
+       + ' ' + std::to_string(e.crc) + ' ' + std::to_string(e.length)
+       + ' ' + time(e.mtime) + ' ' + time(e.ctime) + ' ' + time(e.ctime_max)
+       + ' ' + std::to_string(e.inode);
+} // Format
+
+bool Parse(std::string_view s, CacheEntry* e) {
+  auto word = [&]() {
+    auto w = s.substr(0, s.find(' '));
+    s.remove_prefix(std::min(s.size(), w.size() + 1));
+    return w;
+  };
+  auto number = [&](auto* n) {
+    auto w = word();
+    auto [p, ec] = std::from_chars(w.data(), w.data() + w.size(), *n);
+    return (ec == std::errc{} && p == w.data() + w.size() && !w.empty());
+  };
+  auto time = [&](timespec* t) {
+    auto w = word();
+    auto dot = w.find('.');
+    if (dot == std::string_view::npos || w.size() - dot != 10)
+      return false;
+    std::int64_t sec = 0, nsec = 0;
+    auto sw = w.substr(0, dot), nw = w.substr(dot + 1);
+    auto [p, ec]   = std::from_chars(sw.data(), sw.data() + sw.size(), sec);
+    auto [q, ec2]  = std::from_chars(nw.data(), nw.data() + nw.size(), nsec);
+    if (ec != std::errc{} || ec2 != std::errc{}
+        || p != sw.data() + sw.size() || q != nw.data() + nw.size())
+      return false;
+    t->tv_sec  = static_cast<time_t>(sec);
+    t->tv_nsec = static_cast<long>(nsec);
+    return true;
+  };
+  return (word() == CacheTag && number(&e->crc) && number(&e->length)
+       && time(&e->mtime) && time(&e->ctime) && time(&e->ctime_max)
+       && number(&e->inode) && s.empty());
+} // Parse
+
+bool Lookup(const std::filesystem::path& fname, CacheEntry* e) {
+  auto buf = std::array<char, MaxEntry>{};
+  auto n = ::getxattr(fname.c_str(), CacheAttr, buf.data(), buf.size());
+  return (n > 0 && Parse(std::string_view{buf.data(),
+                                          static_cast<std::size_t>(n)}, e));
+} // Lookup
+
+/* Best effort: a file system without user attributes, or a file we may not
+   write, simply goes uncached, as does one whose ctime comes from a clock
+   other than ours, such as a file server's.  */
+void Store(const std::filesystem::path& fname, CacheEntry e) {
+  ::clock_gettime(CLOCK_REALTIME, &e.ctime_max);
+  e.ctime_max.tv_nsec += StoreSlack;
+  if (e.ctime_max.tv_nsec >= 1'000'000'000) {
+    e.ctime_max.tv_sec  += 1;
+    e.ctime_max.tv_nsec -= 1'000'000'000;
+  }
+  auto s = Format(e);
+  if (::setxattr(fname.c_str(), CacheAttr, s.data(), s.size(), 0) != 0)
+    return;
+  struct stat st;
+  if (::stat(fname.c_str(), &st) != 0 || !Matches(e, Describe(st)))
+    ::removexattr(fname.c_str(), CacheAttr);
+} // Store
+
+// Pick about one in `n` cache hits for a re-read.
+bool Sample(unsigned n) {
+  if (n == 0)
+    return false;
+  thread_local auto rng = std::minstd_rand{std::random_device{}()};
+  return (std::uniform_int_distribution<unsigned>{0, n - 1}(rng) == 0);
+} // Sample
+
+} // anonymous
+
+/* A file modified within the current timestamp tick could change again
+   without moving its mtime, so, as git does for its index, such a file is
+   summed but not cached until its mtime is a second or more in the past.
+   Likewise nothing is stored if the file changed while it was being read.  */
+
+CrcType CrcSumCached(const std::filesystem::path& fname,
+                     std::streamsize* length, const SumOptions& opts)
+{
+  auto plain = opts;
+  plain.cache = Cache::Off;
+
+  struct stat st;
+  if (::stat(fname.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+    return CrcSumFile(fname, length, plain);
+  auto before = Describe(st);
+
+  auto cached = CacheEntry{};
+  bool hit = (opts.cache == Cache::Use && Lookup(fname, &cached)
+              && Matches(cached, before));
+  if (hit && !Sample(opts.verify)) {
+    if (length)
+      *length = static_cast<std::streamsize>(cached.length);
+    return cached.crc;
+  }
+
+  timespec start;
+  ::clock_gettime(CLOCK_REALTIME, &start);
+  auto len = std::streamsize{0};
+  auto crc = CrcSumFile(fname, &len, plain);
+  if (length)
+    *length = len;
+  if (hit) {
+    if (crc != cached.crc || static_cast<std::uintmax_t>(len) != cached.length)
+      throw std::runtime_error{"cached checksum does not match the file"};
+    return crc;
+  }
+
+  if (::stat(fname.c_str(), &st) != 0)
+    return crc;
+  auto after = Describe(st);
+  if (!Matches(before, after) || after.length != std::uintmax_t(len)
+      || after.mtime.tv_sec + 1 >= start.tv_sec)
+    return crc;
+  after.crc = crc;
+  Store(fname, after);
+  return crc;
+} // CrcSumCached
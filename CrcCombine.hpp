@@ -0,0 +1,14 @@
+#pragma once
+#include "CrcConsts.hpp"
+#include "CrcUpdate.hpp"
+#include <cstdint>
+
+/// Return the raw CRC of A followed by B, given crc1 = CRC(A), crc2 = CRC(B)
+/// and len2 = length of B in bytes.  Both CRCs start from 0 and are not yet
+/// complemented or length-suffixed, i.e. as returned by the cksum_* kernels.
+constexpr CrcType CrcCombine(CrcType crc1, CrcType crc2, std::uint64_t len2)
+  noexcept
+{
+  using C = tjg::crc::Crc32Consts;
+  return static_cast<CrcType>(C::Shift(crc1, len2)) ^ crc2;
+} // CrcCombine
@@ -7,6 +7,14 @@
 
 namespace tjg::crc {
 
+/// Reverse the low `bits` bits of x.
+constexpr std::uint64_t Reflect(std::uint64_t x, int bits) noexcept {
+  std::uint64_t r = 0;
+  for (int i = 0; i != bits; ++i, x >>= 1)
+    r = (r << 1) | (x & 1);
+  return r;
+} // Reflect
+
 template<int _Bits_, std::uint64_t _PolyNoTop_>
 requires (_Bits_ >= 3 && _Bits_ <= 64)
 struct CrcConsts {
@@ -55,10 +63,53 @@ private:
   } // ComputeMu
 
 public:
-  static constexpr std::uint64_t K128_lo = XpowMod<1*128>();
-  static constexpr std::uint64_t K128_hi = XpowMod<1*128 + 64>();
-  static constexpr std::uint64_t K512_lo = XpowMod<4*128>();
-  static constexpr std::uint64_t K512_hi = XpowMod<4*128 + 64>();
+  /// Multiply a(x) by b(x) modulo P(x).  Both operands have degree < Bits.
+  static constexpr std::uint64_t MulMod(std::uint64_t a, std::uint64_t b)
+    noexcept
+  {
+    constexpr std::uint64_t TopBit = std::uint64_t{1} << (Bits-1);
+    std::uint64_t r = 0;
+    for (int i = Bits-1; i >= 0; --i) {
+      const bool carry = ((r & TopBit) != 0);
+      r = (r << 1) & Mask;
+      if (carry) r ^= Poly;
+      if ((b >> i) & 1) r ^= a;
+    }
+    return r;
+  } // MulMod
+
+  /// Run-time x^exp mod P(x) by square-and-multiply.
+  static constexpr std::uint64_t XpowMod(std::uint64_t exp) noexcept {
+    std::uint64_t r  = 1;
+    std::uint64_t sq = 2;
+    for ( ; exp; exp >>= 1) {
+      if (exp & 1) r = MulMod(r, sq);
+      sq = MulMod(sq, sq);
+    }
+    return r;
+  } // XpowMod
+
+  /// Advance a raw (non-complemented) CRC over `bytes` zero bytes.
+  static constexpr std::uint64_t Shift(std::uint64_t crc, std::uint64_t bytes)
+    noexcept
+    { return MulMod(crc, XpowMod(8 * bytes)); }
+
+  /// Constants that fold a 128-bit block forward over `Blocks` 128-bit blocks.
+  template<int Blocks> requires (Blocks >= 1)
+  static constexpr std::uint64_t FoldK_lo = XpowMod<Blocks*128>();
+  template<int Blocks> requires (Blocks >= 1)
+  static constexpr std::uint64_t FoldK_hi = XpowMod<Blocks*128 + 64>();
+
+  static constexpr std::uint64_t K128_lo  = FoldK_lo< 1>;
+  static constexpr std::uint64_t K128_hi  = FoldK_hi< 1>;
+  static constexpr std::uint64_t K256_lo  = FoldK_lo< 2>;
+  static constexpr std::uint64_t K256_hi  = FoldK_hi< 2>;
+  static constexpr std::uint64_t K512_lo  = FoldK_lo< 4>;
+  static constexpr std::uint64_t K512_hi  = FoldK_hi< 4>;
+  static constexpr std::uint64_t K1024_lo = FoldK_lo< 8>;
+  static constexpr std::uint64_t K1024_hi = FoldK_hi< 8>;
+  static constexpr std::uint64_t K2048_lo = FoldK_lo<16>;
+  static constexpr std::uint64_t K2048_hi = FoldK_hi<16>;
   static constexpr std::uint64_t Mu2N    = ComputeMu();
 }; // CrcConsts
 
@@ -0,0 +1,22 @@
+#include "CrcEngine.hpp"
+
+#if USE_VMULL_CRC32
+#include <sys/auxv.h>
+#endif
+
+/* Whether this CPU can run the carry-less multiply units: CrcFold.cpp and
+   cksum_simd.cpp, both built for ISA level 1.  This unit is built for the
+   baseline, so that asking is safe on any CPU, and has no dependencies, so
+   that the generic engine links without the cksum readers.  */
+
+bool tjg::crc::FoldSupported() noexcept {
+#if USE_PCLMUL_CRC32
+  static const bool supported = (__builtin_cpu_supports("pclmul") > 0
+                              && __builtin_cpu_supports("avx")    > 0);
+  return supported;
+#elif USE_VMULL_CRC32
+  return (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+#else
+  return false;
+#endif
+} // FoldSupported
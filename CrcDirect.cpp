@@ -0,0 +1,149 @@
+#include "cksum.hpp"
+#include "FileDesc.hpp"
+
+#include <filesystem>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <cerrno>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Bytes per O_DIRECT read: one 2 MiB huge page.  Every offset and length is
+   then a multiple of any device's logical block size, so only the final
+   read can come up short.  */
+constexpr std::size_t DirectLen = std::size_t{2} << 20;
+
+namespace {
+
+/* Read buffers kept for reuse across files and threads, since huge pages
+   are scarce and costly to fault in.  Each is a 2 MiB page from the huge
+   page pool if one is reserved, else an aligned 2 MiB region marked for
+   transparent huge pages.  Buffers are pooled by the NUMA node of the
+   thread that took them, and first touched by it, so that a thread pinned
+   to a node (--numa) reads into memory local to it.  */
+class BufferPool {
+public:
+  BufferPool() = default;
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+  ~BufferPool() {
+    for (const auto& [node, bufs]: _free) {
+      for (auto p: bufs)
+        ::munmap(p, DirectLen);
+    }
+  }
+
+  std::byte* take(unsigned node) {
+    {
+      auto lock = std::lock_guard{_mtx};
+      if (auto& bufs = _free[node]; !bufs.empty()) {
+        auto p = bufs.back();
+        bufs.pop_back();
+        return p;
+      }
+    }
+    return Allocate();
+  }
+
+  void give(std::byte* p, unsigned node) {
+    auto lock = std::lock_guard{_mtx};
+    _free[node].push_back(p);
+  }
+
+private:
+  std::mutex _mtx;
+  std::map<unsigned, std::vector<std::byte*>> _free;
+
+  static std::byte* Allocate() {
+    constexpr int Prot = PROT_READ | PROT_WRITE;
+    constexpr int Anon = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_HUGETLB
+    constexpr int Huge2M = MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+    if (auto p = ::mmap(nullptr, DirectLen, Prot, Anon | Huge2M, -1, 0);
+        p != MAP_FAILED)
+      return static_cast<std::byte*>(p);
+#endif
+    // Over-allocate and trim to a 2 MiB boundary.
+    auto p = ::mmap(nullptr, 2 * DirectLen, Prot, Anon, -1, 0);
+    if (p == MAP_FAILED)
+      throw std::system_error{errno, std::generic_category(), "mmap"};
+    auto base = reinterpret_cast<std::uintptr_t>(p);
+    auto head = (DirectLen - base % DirectLen) % DirectLen;
+    if (head != 0)
+      ::munmap(p, head);
+    ::munmap(reinterpret_cast<void*>(base + head + DirectLen),
+             DirectLen - head);
+    auto bp = reinterpret_cast<std::byte*>(base + head);
+    ::madvise(bp, DirectLen, MADV_HUGEPAGE);
+    return bp;
+  } // Allocate
+}; // BufferPool
+
+BufferPool Pool;
+
+unsigned CurrentNode() noexcept {
+  unsigned cpu = 0, node = 0;
+  ::getcpu(&cpu, &node);
+  return node;
+} // CurrentNode
+
+struct PoolBuffer {
+  unsigned node = CurrentNode();
+  std::byte* data = Pool.take(node);
+  PoolBuffer() = default;
+  PoolBuffer(const PoolBuffer&) = delete;
+  PoolBuffer& operator=(const PoolBuffer&) = delete;
+  ~PoolBuffer() { Pool.give(data, node); }
+}; // PoolBuffer
+
+} // anonymous
+
+/* Checksum a file or block device with O_DIRECT reads, so a scrub neither
+   evicts other data from the page cache nor leaves its own behind.  A file
+   system that refuses O_DIRECT gets the stream reader; one that rejects an
+   individual read, as it may at an unaligned tail, gets buffered reads from
+   there on.  */
+
+CrcType CrcSumDirect(const std::filesystem::path& fname,
+                     std::streamsize* length)
+{
+  auto file = FileDesc{::open(fname.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT)};
+  if (file.fd < 0) {
+    if (errno == EINVAL)
+      return CrcSumFile(fname, length, SumOptions{});
+    throw std::runtime_error{"cannot read"};
+  }
+  ::posix_fadvise(file.fd, 0, 0, POSIX_FADV_NOREUSE);
+
+  auto buf = PoolBuffer{};
+  auto acc = CrcAccumulator{};
+  for (bool direct = true;;) {
+    auto off = static_cast<off_t>(acc.length());
+    auto n = ::pread(file.fd, buf.data, DirectLen, off);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      if (errno == EINVAL && direct) {
+        direct = false;
+        ::fcntl(file.fd, F_SETFL, ::fcntl(file.fd, F_GETFL) & ~O_DIRECT);
+        continue;
+      }
+      throw std::system_error{errno, std::generic_category(), "read"};
+    }
+    if (n == 0)
+      break;
+    acc.update(std::span{buf.data, static_cast<std::size_t>(n)});
+  }
+
+  if (length)
+    *length = static_cast<std::streamsize>(acc.length());
+  return acc.finalize();
+} // CrcSumDirect
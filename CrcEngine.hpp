@@ -0,0 +1,294 @@
+#pragma once
+#include "CrcConsts.hpp"
+#include "Int.hpp"
+
+#include <array>
+#include <memory>
+#include <bit>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace tjg::crc {
+
+/// A CRC in the Rocksoft model: width, generator without its top bit,
+/// register bit order, initial register value and final xor.  Init and
+/// XorOut are given as register values, i.e. in the algorithm's own bit order.
+template<int _Bits_, std::uint64_t _Poly_, bool _Reflect_,
+         std::uint64_t _Init_, std::uint64_t _XorOut_>
+requires (_Bits_ >= 8 && _Bits_ <= 64)
+struct CrcParams {
+  using Consts = CrcConsts<_Bits_, _Poly_>;
+  using value_type = std::conditional_t<(_Bits_ <= 32), std::uint32_t,
+                                                        std::uint64_t>;
+  static constexpr int  Bits    = _Bits_;
+  static constexpr auto Poly    = value_type(_Poly_);
+  static constexpr bool Reflect = _Reflect_;
+  static constexpr auto Mask    = value_type(Consts::Mask);
+  static constexpr auto Init    = value_type(_Init_   & Consts::Mask);
+  static constexpr auto XorOut  = value_type(_XorOut_ & Consts::Mask);
+}; // CrcParams
+
+// POSIX cksum before its length suffix is appended (see CrcFinal).
+using Crc32Cksum = CrcParams<32, 0x04c11db7, false, 0, 0xffffffff>;
+using Crc32Gzip  = CrcParams<32, 0x04c11db7, true, 0xffffffff, 0xffffffff>;
+using Crc32C     = CrcParams<32, 0x1edc6f41, true, 0xffffffff, 0xffffffff>;
+using Crc64Xz    = CrcParams<64, 0x42f0e1eba9ea3693, true,
+                             ~std::uint64_t{0}, ~std::uint64_t{0}>;
+
+template<typename P>
+using CrcValue = typename P::value_type;
+
+/// Tables[s][b] is the register after byte b followed by s zero bytes,
+/// starting from zero.  Entries are native integers in register order.
+template<typename P, int Slices>
+requires (Slices >= 1)
+constexpr auto MakeTables() noexcept {
+  using T = CrcValue<P>;
+  auto tab = std::array<std::array<T, 256>, Slices>{};
+  for (int b = 0; b != 256; ++b) {
+    auto crc = T{0};
+    if constexpr (P::Reflect) {
+      constexpr auto Rev = T(Reflect(P::Poly, P::Bits));
+      crc = T(b);
+      for (int i = 0; i != 8; ++i)
+        crc = (crc & 1) ? ((crc >> 1) ^ Rev) : (crc >> 1);
+    }
+    else {
+      constexpr auto TopBit = T{1} << (P::Bits-1);
+      crc = T(b) << (P::Bits-8);
+      for (int i = 0; i != 8; ++i)
+        crc = (crc & TopBit) ? (((crc << 1) ^ P::Poly) & P::Mask)
+                             : ((crc << 1) & P::Mask);
+    }
+    tab[0][b] = crc;
+  }
+  for (int s = 1; s != Slices; ++s) {
+    for (int b = 0; b != 256; ++b) {
+      auto crc = tab[s-1][b];
+      if constexpr (P::Reflect)
+        tab[s][b] = (crc >> 8) ^ tab[0][crc & 0xff];
+      else
+        tab[s][b] = ((crc << 8) & P::Mask) ^ tab[0][crc >> (P::Bits-8)];
+    }
+  }
+  return tab;
+} // MakeTables
+
+template<typename P, int Slices = 8>
+inline constexpr auto CrcTables = MakeTables<P, Slices>();
+
+// The byte-wise updates are also used by the clmul fold unit, which is
+// compiled for a newer ISA; always_inline keeps such a copy from being shared.
+template<typename P>
+[[gnu::always_inline]]
+constexpr CrcValue<P> UpdateByte(CrcValue<P> crc, std::byte b) noexcept {
+  const auto& tab = CrcTables<P>[0];
+  const auto x = std::to_integer<unsigned>(b);
+  if constexpr (P::Reflect)
+    return (crc >> 8) ^ tab[(crc ^ x) & 0xff];
+  else
+    return ((crc << 8) & P::Mask) ^ tab[((crc >> (P::Bits-8)) ^ x) & 0xff];
+} // UpdateByte
+
+template<typename P>
+[[gnu::always_inline]]
+inline CrcValue<P> UpdateBytes(CrcValue<P> crc, const void* buf,
+                               std::size_t len) noexcept
+{
+  auto cp = reinterpret_cast<const std::byte*>(buf);
+  while (len--)
+    crc = UpdateByte<P>(crc, *cp++);
+  return crc;
+} // UpdateBytes
+
+/// Words are loaded in message order: big-endian for non-reflected CRCs.
+template<typename P>
+using SliceWord = tjg::Int<std::uint64_t, P::Reflect ? std::endian::little
+                                                     : std::endian::big>;
+
+/// One table step over the Slices bytes at p.  A lone chain is bound by
+/// latency: the register only reaches the leading bytes, so lookups for the
+/// others need not wait for it, and they are innermost in the xor chain.  The
+/// split into 32-bit halves measured best for non-reflected CRCs there, the
+/// per-byte mix for reflected ones.  Interleaved chains are bound by
+/// throughput instead, where one xor of the whole word is cheapest.
+template<typename P, int Slices, bool Interleaved = false>
+requires (Slices % 8 == 0 && Slices <= 64)
+[[gnu::always_inline]]
+inline CrcValue<P> SliceStep(CrcValue<P> crc, const SliceWord<P>* p) noexcept {
+  using std::uint64_t;
+  const auto& tab = CrcTables<P, Slices>;
+  // Index byte m of the step in message order.
+  const auto c = P::Reflect ? uint64_t{crc} : uint64_t{crc} << (64-P::Bits);
+  auto byte = [&](std::size_t m) {
+    const auto d = uint64_t{p[m / 8]};
+    const auto x = (m < 8) ? c : uint64_t{0};
+    m %= 8;
+    if constexpr (Interleaved) {
+      return ((d ^ x) >> 8*(P::Reflect ? m : 7-m)) & 0xff;
+    }
+    else if constexpr (P::Reflect) {
+      return ((d >> 8*m) ^ (x >> 8*m)) & 0xff;
+    }
+    else {
+      const auto hi = std::uint32_t(d >> 32) ^ std::uint32_t(x >> 32);
+      const auto lo = std::uint32_t(d) ^ std::uint32_t(x);
+      const auto s  = 8 * (7-m);
+      return ((s < 32) ? (lo >> s) : (hi >> (s-32))) & 0xff;
+    }
+  };
+  return [&]<std::size_t... M>(std::index_sequence<M...>) {
+    return (tab[Slices-1-M][byte(M)] ^ ...);
+  }(std::make_index_sequence<Slices>{});
+} // SliceStep
+
+/// Table-driven update, Slices bytes per step.  Wider steps trade table
+/// footprint (Slices KiB per 32-bit CRC) for more independent lookups.
+template<typename P, int Slices = 8>
+requires (Slices % 8 == 0 && Slices <= 64)
+CrcValue<P> UpdateSlice(CrcValue<P> crc, const void* buf, std::size_t size)
+  noexcept
+{
+  using Word = SliceWord<P>;
+  static_assert(sizeof(Word) == sizeof(std::uint64_t));
+  constexpr std::size_t Words = Slices / sizeof(Word);
+
+  if (size < Slices) {
+    if constexpr (Slices > 8)
+      return UpdateSlice<P, 8>(crc, buf, size);
+    else
+      return UpdateBytes<P>(crc, buf, size);
+  }
+  auto bp = reinterpret_cast<const std::byte*>(buf);
+  {
+    auto head =
+              std::size_t{reinterpret_cast<std::uintptr_t>(bp) % alignof(Word)};
+    if (head != 0) [[unlikely]] {
+      head  = alignof(Word) - head;
+      crc   = UpdateBytes<P>(crc, bp, head);
+      bp   += head;
+      size -= head;
+    }
+  }
+  auto ap = std::assume_aligned<alignof(Word)>(bp);
+  auto p  = reinterpret_cast<const Word*>(ap);
+  auto n  = size / Slices;
+  auto r  = size % Slices;
+  for (std::size_t i = 0; i != n; ++i, p += Words)
+    crc = SliceStep<P, Slices>(crc, p);
+  if constexpr (Slices > 8)
+    return UpdateSlice<P, 8>(crc, p, r);
+  else
+    return UpdateBytes<P>(crc, p, r);
+} // UpdateSlice
+
+/// ShiftTables[i][b] advances register byte i, holding b, over Bytes zero
+/// bytes.  The shift is linear, so a whole register takes one lookup per byte.
+template<typename P, std::uint64_t Bytes>
+constexpr auto MakeShiftTables() noexcept {
+  using T = CrcValue<P>;
+  using C = typename P::Consts;
+  constexpr int N = (P::Bits + 7) / 8;
+  // Reflect() is its own inverse; it maps registers to polynomials and back.
+  auto poly = [](std::uint64_t v)
+    { return P::Reflect ? Reflect(v, P::Bits) : v; };
+  const auto k = C::XpowMod(8 * Bytes);
+  auto tab = std::array<std::array<T, 256>, N>{};
+  for (int i = 0; i != N; ++i) {
+    for (int b = 0; b != 256; ++b) {
+      const auto v = (std::uint64_t(b) << 8*i) & C::Mask;
+      tab[i][b] = T(poly(C::MulMod(poly(v), k)));
+    }
+  }
+  return tab;
+} // MakeShiftTables
+
+template<typename P, std::uint64_t Bytes>
+inline constexpr auto ShiftTables = MakeShiftTables<P, Bytes>();
+
+/// Advance the raw register over Bytes zero bytes.
+template<typename P, std::uint64_t Bytes>
+[[gnu::always_inline]]
+constexpr CrcValue<P> ShiftBy(CrcValue<P> crc) noexcept {
+  const auto& tab = ShiftTables<P, Bytes>;
+  return [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return (tab[I][(crc >> 8*I) & 0xff] ^ ...);
+  }(std::make_index_sequence<tab.size()>{});
+} // ShiftBy
+
+/// Table-driven update over Streams interleaved sub-streams.  Each chunk of
+/// Streams*Block bytes is split into Streams contiguous blocks whose slice-by-8
+/// chains advance side by side, then merged with ShiftBy<Block>.
+template<typename P, int Streams = 4, std::size_t Block = 1024>
+requires (Streams >= 2 && Block % 8 == 0)
+CrcValue<P> UpdateInterleaved(CrcValue<P> crc, const void* buf,
+                              std::size_t size) noexcept
+{
+  using Word = SliceWord<P>;
+  constexpr std::size_t Chunk = Streams * Block;
+  constexpr std::size_t Words = Block / sizeof(Word);
+
+  if (size < Chunk + alignof(Word))
+    return UpdateSlice<P>(crc, buf, size);
+  auto bp = reinterpret_cast<const std::byte*>(buf);
+  {
+    auto head =
+              std::size_t{reinterpret_cast<std::uintptr_t>(bp) % alignof(Word)};
+    if (head != 0) [[unlikely]] {
+      head  = alignof(Word) - head;
+      crc   = UpdateBytes<P>(crc, bp, head);
+      bp   += head;
+      size -= head;
+    }
+  }
+  auto ap = std::assume_aligned<alignof(Word)>(bp);
+  auto p  = reinterpret_cast<const Word*>(ap);
+  auto n  = size / Chunk;
+  auto r  = size % Chunk;
+  for (std::size_t i = 0; i != n; ++i, p += Streams * Words) {
+    auto c = std::array<CrcValue<P>, Streams>{};
+    c[0] = crc;
+    for (std::size_t k = 0; k != Words; ++k) {
+      [&]<std::size_t... S>(std::index_sequence<S...>) {
+        ((c[S] = SliceStep<P, 8, true>(c[S], p + S * Words + k)), ...);
+      }(std::make_index_sequence<Streams>{});
+    }
+    crc = c[0];
+    for (std::size_t s = 1; s != Streams; ++s)
+      crc = ShiftBy<P, Block>(crc) ^ c[s];
+  }
+  return UpdateSlice<P>(crc, p, r);
+} // UpdateInterleaved
+
+/// Carry-less multiply folding; defined in CrcFold.cpp for the parameter sets
+/// above.  Only call it when FoldSupported().  Its loop, FoldBlocks in
+/// CrcFold.hpp, is also cksum_simd's, instantiated for Crc32Cksum.
+template<typename P>
+CrcValue<P> UpdateFold(CrcValue<P> crc, const void* buf, std::size_t size)
+  noexcept;
+
+bool FoldSupported() noexcept;
+
+/// Advance the raw register over buf, using the fastest kernel available.
+template<typename P>
+CrcValue<P> Update(CrcValue<P> crc, const void* buf, std::size_t size)
+  noexcept
+{
+  constexpr std::size_t FoldMin = 256;
+  if (size >= FoldMin && FoldSupported())
+    return UpdateFold<P>(crc, buf, size);
+  return UpdateSlice<P>(crc, buf, size);
+} // Update
+
+template<typename P>
+constexpr CrcValue<P> Finalize(CrcValue<P> crc) noexcept
+  { return crc ^ P::XorOut; }
+
+/// The complete CRC of one buffer.
+template<typename P>
+CrcValue<P> Checksum(const void* buf, std::size_t size) noexcept
+  { return Finalize<P>(Update<P>(P::Init, buf, size)); }
+
+} // tjg::crc
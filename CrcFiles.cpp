@@ -0,0 +1,242 @@
+#include "cksum.hpp"
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <span>
+#include <chrono>
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <cstdint>
+#include <cstddef>
+
+#include <sys/resource.h>
+
+namespace {
+
+/* Reads in flight across all files.  A file takes as many units as it keeps
+   reads outstanding, its threads or io_uring depth, cut down to the whole
+   budget if need be, and waits until they are free.  */
+class IoBudget {
+public:
+  explicit IoBudget(unsigned units) noexcept : _free{units}, _total{units} { }
+
+  /// Fit opts to the budget and take its units, or return 0 if unlimited.
+  unsigned acquire(SumOptions* opts) {
+    if (_total == 0)
+      return 0;
+    opts->threads = std::min(opts->threads, _total);
+    opts->depth   = std::min(opts->depth,   _total);
+    auto units = (opts->threads > 1)              ? opts->threads
+               : (opts->reader == Reader::Uring) ? opts->depth
+               : 1u;
+    auto lock = std::unique_lock{_mtx};
+    _freed.wait(lock, [&]() { return _free >= units; });
+    _free -= units;
+    return units;
+  }
+
+  void release(unsigned units) {
+    if (units == 0)
+      return;
+    {
+      auto lock = std::lock_guard{_mtx};
+      _free += units;
+    }
+    _freed.notify_all();
+  }
+
+private:
+  std::mutex _mtx;
+  std::condition_variable _freed;
+  unsigned _free;
+  const unsigned _total;
+}; // IoBudget
+
+/// The calling thread's clocks, for SumStats.
+struct ThreadTimes {
+  std::chrono::steady_clock::time_point wall;
+  double user   = 0;
+  double system = 0;
+  double crc    = 0;
+
+  static ThreadTimes Now() noexcept {
+    auto secs = [](const timeval& tv)
+      { return double(tv.tv_sec) + 1e-6 * double(tv.tv_usec); };
+    auto t = ThreadTimes{std::chrono::steady_clock::now()};
+    struct rusage ru;
+    if (::getrusage(RUSAGE_THREAD, &ru) == 0) {
+      t.user   = secs(ru.ru_utime);
+      t.system = secs(ru.ru_stime);
+    }
+    t.crc = CksumKernelTime();
+    return t;
+  }
+
+  SumStats since(const ThreadTimes& t0) const noexcept {
+    auto s = SumStats{};
+    s.wall    = std::chrono::duration<double>{wall - t0.wall}.count();
+    s.user    = user   - t0.user;
+    s.system  = system - t0.system;
+    s.crc     = crc    - t0.crc;
+    s.blocked = std::max(0.0, s.wall - s.user - s.system);
+    return s;
+  }
+}; // ThreadTimes
+
+SumResult SumOne(const std::filesystem::path& fname, SumOptions opts,
+                 IoBudget& budget) noexcept
+{
+  auto result = SumResult{};
+  unsigned units = 0;
+  try {
+    units = budget.acquire(&opts);
+    if (opts.numa)
+      NumaPlace(fname, opts);
+    const auto start = opts.stats ? ThreadTimes::Now() : ThreadTimes{};
+    const SumResult* prior = nullptr;
+    if (opts.prior) {
+      if (auto it = opts.prior->find(fname.generic_string());
+          it != opts.prior->end())
+        prior = &it->second;
+    }
+    if (opts.block != 0) {
+      result.blocks.size = opts.block;
+      result.crc = CrcSumPath(fname, &result.length, &result.blocks);
+    }
+    else if (prior) {
+      result.crc = CrcSumAppended(fname, *prior, &result.length);
+    }
+    else {
+      result.crc = CrcSumFile(fname, &result.length, opts);
+    }
+    if (opts.stats)
+      result.stats = ThreadTimes::Now().since(start);
+  }
+  catch (const std::exception& x) {
+    result.error = x.what();
+  }
+  catch (...) {
+    result.error = "unknown error";
+  }
+  budget.release(units);
+  return result;
+} // SumOne
+
+/* Produce `count` results on `jobs` worker threads.  Workers take the next
+   index from a shared counter.  In ordered mode the calling thread reports
+   results in index order as soon as each becomes available; otherwise each
+   worker reports its own result as it finishes.  `report` is never entered
+   by two threads at once.  */
+
+void RunJobs(std::size_t count, unsigned jobs, bool ordered,
+             const std::function<SumResult(std::size_t)>& work,
+             const SumReport& report)
+{
+  if (count == 0)
+    return;
+  jobs = static_cast<unsigned>(std::clamp<std::size_t>(jobs, 1, count));
+  if (jobs <= 1) {
+    for (std::size_t i = 0; i != count; ++i)
+      report(i, work(i));
+    return;
+  }
+
+  auto next = std::atomic<std::size_t>{0};
+  auto mtx  = std::mutex{};
+  auto done = std::condition_variable{};
+  auto results = std::vector<std::optional<SumResult>>(ordered ? count : 0);
+
+  auto worker = [&]() {
+    for (;;) {
+      auto i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= count)
+        break;
+      auto result = work(i);
+      auto lock = std::unique_lock{mtx};
+      if (ordered) {
+        results[i] = std::move(result);
+        lock.unlock();
+        done.notify_one();
+      }
+      else {
+        report(i, result);
+      }
+    }
+  };
+
+  auto pool = std::vector<std::jthread>{};
+  pool.reserve(jobs);
+  for (unsigned j = 0; j != jobs; ++j)
+    pool.emplace_back(worker);
+
+  if (ordered) {
+    for (std::size_t i = 0; i != count; ++i) {
+      auto lock = std::unique_lock{mtx};
+      done.wait(lock, [&]() { return results[i].has_value(); });
+      auto result = std::move(*results[i]);
+      results[i].reset();
+      lock.unlock();
+      report(i, result);
+    }
+  }
+} // RunJobs
+
+} // anonymous
+
+/* The reader dispatch lives here rather than with the kernels, so that a
+   program needing only kernels does not link every reader.  */
+
+CrcType CrcSumFile(const std::filesystem::path& fname,
+                   std::streamsize* length, const SumOptions& opts)
+{
+  if (opts.cache != Cache::Off)
+    return CrcSumCached(fname, length, opts);
+  if (opts.threads > 1)
+    return CrcSumParallel(fname, length, opts);
+  switch (opts.reader) {
+    case Reader::Stream: break;
+    case Reader::Mmap:   return CrcSumMapped(fname, length, opts.populate);
+    case Reader::Uring:  return CrcSumUring (fname, length, opts.depth);
+    case Reader::Direct: return CrcSumDirect(fname, length);
+  }
+  return CrcSumPath(fname, length);
+} // CrcSumFile
+
+void CrcSumFiles(std::span<const std::filesystem::path> files,
+                 const SumOptions& opts, unsigned jobs, bool ordered,
+                 const SumReport& report)
+{
+  auto budget = IoBudget{opts.budget};
+  RunJobs(files.size(), jobs, ordered,
+          [&](std::size_t i) { return SumOne(files[i], opts, budget); },
+          report);
+} // CrcSumFiles
+
+/* A file whose size already differs from its entry cannot match, so it is
+   reported with that size and without being read.  */
+
+void CrcCheckFiles(std::span<const CheckEntry> entries,
+                   const SumOptions& opts, unsigned jobs, bool ordered,
+                   const SumReport& report)
+{
+  auto budget = IoBudget{opts.budget};
+  auto work = [&](std::size_t i) {
+    const auto& e = entries[i];
+    auto ec = std::error_code{};
+    auto size = std::filesystem::file_size(e.name, ec);
+    if (!ec && size != static_cast<std::uintmax_t>(e.length)) {
+      auto result = SumResult{};
+      result.length = static_cast<std::streamsize>(size);
+      return result;
+    }
+    return SumOne(e.name, opts, budget);
+  };
+  RunJobs(entries.size(), jobs, ordered, work, report);
+} // CrcCheckFiles
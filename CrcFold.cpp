@@ -0,0 +1,62 @@
+#include "CrcEngine.hpp"
+#include "CrcBarrett.hpp"
+#include "Int.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+#define TJG_SIMD_ISA 1
+#include "Simd.hpp"
+#include "CrcFold.hpp"
+
+using simd::uint128_t;
+
+namespace tjg::crc {
+
+template<typename P>
+CrcValue<P> UpdateFold(CrcValue<P> crc, const void* buf, std::size_t size)
+  noexcept
+{
+  constexpr auto BlockSize = sizeof(uint128_t);
+  if (size < 3 * BlockSize)
+    return UpdateBytes<P>(crc, buf, size);
+  auto bp = reinterpret_cast<const std::byte*>(buf);
+  auto n  = size / BlockSize;
+  auto r  = size % BlockSize;
+
+  // The register enters at the top of the first block in either bit order.
+  auto init = uint128_t{crc};
+  if constexpr (!P::Reflect)
+    init <<= 128 - P::Bits;
+  auto u = FoldBlocks<P, 4>(init, bp, n);
+
+  // Narrow CRCs reduce the last block through the tables in memory order.
+  using C = typename P::Consts;
+  if constexpr (P::Bits < 32) {
+    crc = CrcValue<P>{0};
+    for (std::size_t i = 0; i != BlockSize; ++i) {
+      auto shift = P::Reflect ? 8*i : 8*((BlockSize-1)-i);
+      crc = UpdateByte<P>(crc, std::byte(u >> shift));
+    }
+  }
+  else if constexpr (P::Reflect) {
+    crc = CrcValue<P>(BarrettReduceReflected<C>(u, simd::clmul));
+  }
+  else {
+    crc = CrcValue<P>(BarrettReduce<C>(u, simd::clmul));
+  }
+  return UpdateBytes<P>(crc, bp + n * BlockSize, r);
+} // UpdateFold
+
+template CrcValue<Crc32Cksum> UpdateFold<Crc32Cksum>(CrcValue<Crc32Cksum>,
+                                          const void*, std::size_t) noexcept;
+template CrcValue<Crc32Gzip>  UpdateFold<Crc32Gzip> (CrcValue<Crc32Gzip>,
+                                          const void*, std::size_t) noexcept;
+template CrcValue<Crc32C>     UpdateFold<Crc32C>    (CrcValue<Crc32C>,
+                                          const void*, std::size_t) noexcept;
+template CrcValue<Crc64Xz>    UpdateFold<Crc64Xz>   (CrcValue<Crc64Xz>,
+                                          const void*, std::size_t) noexcept;
+
+} // tjg::crc
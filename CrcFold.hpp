@@ -0,0 +1,108 @@
+#pragma once
+// The carry-less multiply fold loop of the generic engine, shared by
+// CrcFold.cpp and cksum_simd.cpp.  Include after Simd.hpp; everything here
+// has internal linkage, so each unit keeps the copy built for its own
+// TJG_SIMD_ISA.
+#include "CrcEngine.hpp"
+#include "Int.hpp"
+
+#include <array>
+#include <utility>
+#include <bit>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+namespace tjg::crc {
+
+namespace {
+
+/* Fold constants for parameter set P.  A non-reflected block is loaded
+   big-endian, so bit i of the register is the coefficient of x^i.  A
+   reflected block is loaded little-endian and bit i is the coefficient of
+   x^(127-i); there the low lane holds the high-order half, and clmul of two
+   reflected operands yields the product times x, so each constant is taken
+   one power lower and bit-reversed.  */
+template<typename P>
+struct FoldConsts {
+  using C = typename P::Consts;
+
+  static constexpr std::uint64_t K(std::uint64_t exp) noexcept {
+    if constexpr (P::Reflect)
+      return Reflect(C::XpowMod(exp - 1), 64);
+    else
+      return C::XpowMod(exp);
+  }
+
+  // {low lane, high lane} that fold a block forward over `blocks` blocks.
+  static constexpr std::array<std::uint64_t, 2> Fold(std::uint64_t blocks)
+    noexcept
+  {
+    const auto d = 128 * blocks;
+    if constexpr (P::Reflect)
+      return {K(d + 64), K(d)};
+    else
+      return {K(d), K(d + 64)};
+  }
+}; // FoldConsts
+
+template<typename P>
+using Block = tjg::Int<simd::uint128_t, P::Reflect ? std::endian::little
+                                                   : std::endian::big>;
+
+/* Fold `num` blocks at buf, which need not be aligned, into init, with N
+   accumulators each folding forward over N blocks per iteration.  The
+   128-bit result is left for the caller to reduce.  */
+template<typename P, std::size_t N>
+requires (N >= 1 && N <= 16)
+simd::uint128_t FoldBlocks(simd::uint128_t init, const std::byte* buf,
+                           std::size_t num) noexcept
+{
+  using Vec = simd::Simd<simd::uint64x2_t>;
+  using F = FoldConsts<P>;
+
+  constexpr auto MakeK = [](std::array<std::uint64_t, 2> k)
+    { return Vec{k[0], k[1]}; };
+  static const auto SingleK = MakeK(F::Fold(1));
+  static const auto WideK   = MakeK(F::Fold(N));
+
+  auto Load = [&buf](std::size_t i) -> Vec {
+    auto x = Block<P>{};
+    std::memcpy(&x, buf + i * sizeof(x), sizeof(x));
+    return Vec{x};
+  };
+
+  auto data0 = Vec{init} ^ Load(0);
+
+  if (N > 1 && num >= 2*N) {
+    auto data = std::array<Vec, N>{};
+    data[0] = data0;
+    for (std::size_t i = 1; i != N; ++i)
+      data[i] = Load(i);
+
+    for ( ; num >= 2*N; num -= N) {
+      buf += N * sizeof(Block<P>);
+      [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        ((data[Is] = ClMulDiag(data[Is], WideK) ^ Load(Is)), ...);
+      }(std::make_index_sequence<N>{});
+    }
+
+    // Fold every accumulator straight onto the last one, each by its own
+    // distance, so the reduction is one clmul deep instead of N-1.
+    data0 = data[N-1];
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      ((data0 ^= ClMulDiag(data[Is], MakeK(F::Fold(N-1-Is)))), ...);
+    }(std::make_index_sequence<N-1>{});
+    num -= N-1;
+    buf += (N-1) * sizeof(Block<P>);
+  }
+  for ( ; num >= 2; --num) {
+    buf += sizeof(Block<P>);
+    data0 = ClMulDiag(data0, SingleK) ^ Load(0);
+  }
+  return simd::uint128_t{data0};
+} // FoldBlocks
+
+} // anonymous
+
+} // tjg::crc
@@ -0,0 +1,112 @@
+#include "cksum.hpp"
+#include "FileDesc.hpp"
+
+#include <filesystem>
+#include <functional>
+#include <array>
+#include <stdexcept>
+#include <system_error>
+#include <cerrno>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+int OpenRead(const std::filesystem::path& fname) {
+  auto fd = ::open(fname.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    throw std::runtime_error{"cannot read"};
+  return fd;
+} // OpenRead
+
+// Fail if the file no longer holds the `length` bytes already summed.
+void CheckLength(int fd, std::uintmax_t length) {
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+    throw std::system_error{errno, std::generic_category(), "fstat"};
+  if (S_ISREG(st.st_mode) && static_cast<std::uintmax_t>(st.st_size) < length)
+    throw std::runtime_error{"file is shorter than before"};
+} // CheckLength
+
+// Position fd after the bytes `prior` covered and resume its checksum.
+void Resume(int fd, const SumResult& prior, CrcAccumulator* acc) {
+  auto length = static_cast<std::uintmax_t>(prior.length);
+  CheckLength(fd, length);
+  if (::lseek(fd, static_cast<off_t>(length), SEEK_SET) < 0)
+    throw std::system_error{errno, std::generic_category(), "lseek"};
+  acc->resume(prior.crc, length);
+} // Resume
+
+SumResult Result(const CrcAccumulator& acc) {
+  auto r = SumResult{};
+  r.crc = acc.finalize();
+  r.length = static_cast<std::streamsize>(acc.length());
+  return r;
+} // Result
+
+} // anonymous
+
+/* Only the appended bytes are read; the earlier ones are taken on trust, so
+   this suits files that are only ever appended to.  The length suffix is
+   taken off the old value (CrcUnfinal), the running CRC continued over the
+   new bytes and the new length appended.  */
+
+CrcType CrcSumAppended(const std::filesystem::path& fname,
+                       const SumResult& prior, std::streamsize* length)
+{
+  auto file = FileDesc{OpenRead(fname)};
+  auto acc = CrcAccumulator{};
+  Resume(file.fd, prior, &acc);
+  acc.update_fd(file.fd);
+  if (length)
+    *length = static_cast<std::streamsize>(acc.length());
+  return acc.finalize();
+} // CrcSumAppended
+
+/* The watch is set before the first read, so no append can slip between
+   reaching end-of-file and waiting for the next change.  Each wakeup reads
+   to the new end-of-file and reports if anything was added.  */
+
+void CrcFollow(const std::filesystem::path& fname, const SumResult* start,
+               const std::function<void(const SumResult&)>& report)
+{
+  auto watch = FileDesc{::inotify_init1(IN_CLOEXEC)};
+  if (watch.fd < 0)
+    throw std::system_error{errno, std::generic_category(), "inotify_init1"};
+  constexpr auto Gone = IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED;
+  if (::inotify_add_watch(watch.fd, fname.c_str(), IN_MODIFY | Gone) < 0)
+    throw std::system_error{errno, std::generic_category(),
+                            "inotify_add_watch"};
+
+  auto file = FileDesc{OpenRead(fname)};
+  auto acc = CrcAccumulator{};
+  if (start)
+    Resume(file.fd, *start, &acc);
+  acc.update_fd(file.fd);
+  report(Result(acc));
+
+  alignas(inotify_event) auto buf = std::array<char, 4096>{};
+  for (;;) {
+    auto n = ::read(watch.fd, buf.data(), buf.size());
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      throw std::system_error{errno, std::generic_category(), "read"};
+    }
+    bool gone = false;
+    for (auto p = buf.data(); p < buf.data() + n; ) {
+      auto ev = reinterpret_cast<const inotify_event*>(p);
+      gone |= ((ev->mask & Gone) != 0);
+      p += sizeof(inotify_event) + ev->len;
+    }
+    CheckLength(file.fd, acc.length());
+    if (acc.update_fd(file.fd) != 0)
+      report(Result(acc));
+    if (gone)
+      return;
+  }
+} // CrcFollow
@@ -0,0 +1,61 @@
+#include "cksum.hpp"
+#include "Int.hpp"
+
+#include <ostream>
+#include <string>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+
+/* A manifest holds one record per file.  As text:
+
+     blocks SIZE COUNT CRC LENGTH NAME
+     HHHHHHHH HHHHHHHH ...
+
+   the cksum line prefixed by the block size and count, then the block CRCs
+   in hex, eight to a line.  In binary, all integers little-endian:
+
+     "CKB2"  u64 SIZE  u64 LENGTH  u64 COUNT  u32 CRC  u32 NAMELEN  NAME
+     u32 CRC[COUNT]
+
+   COUNT is 64 bits like LENGTH, since a large file in small blocks can
+   have more than 2^32 of them.  */
+
+namespace {
+
+constexpr auto PerLine = std::size_t{8};
+
+template<std::unsigned_integral T>
+void Put(std::ostream& out, T x) {
+  auto v = tjg::Int<T, std::endian::little>{x};
+  out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+} // anonymous
+
+void WriteManifest(std::ostream& out, const std::string& name,
+                   const SumResult& result, bool binary)
+{
+  const auto& crcs = result.blocks.crcs;
+  if (binary) {
+    out.write("CKB2", 4);
+    Put(out, std::uint64_t{result.blocks.size});
+    Put(out, static_cast<std::uint64_t>(result.length));
+    Put(out, static_cast<std::uint64_t>(crcs.size()));
+    Put(out, std::uint32_t{result.crc});
+    Put(out, static_cast<std::uint32_t>(name.size()));
+    out.write(name.data(), static_cast<std::streamsize>(name.size()));
+    for (auto c: crcs)
+      Put(out, std::uint32_t{c});
+    return;
+  }
+  out << "blocks " << result.blocks.size << ' ' << crcs.size()
+      << ' ' << result.crc << ' ' << result.length << ' ' << name << '\n';
+  for (std::size_t i = 0; i != crcs.size(); ++i) {
+    auto hex = std::array<char, 9>{};
+    std::snprintf(hex.data(), hex.size(), "%08x", unsigned{crcs[i]});
+    out << hex.data() << ((i % PerLine == PerLine-1 || i+1 == crcs.size())
+                          ? '\n' : ' ');
+  }
+} // WriteManifest
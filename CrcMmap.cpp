@@ -0,0 +1,127 @@
+#include "cksum.hpp"
+#include "FileDesc.hpp"
+
+#include <filesystem>
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <cerrno>
+#include <cstdint>
+
+#include <csetjmp>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Bytes handed to the kernel per call; the following window is prefetched
+   with MADV_WILLNEED while the current one is being summed.  */
+constexpr std::size_t MapWindow = 128 * BufLen;
+
+namespace {
+
+struct Mapping {
+  void* addr = MAP_FAILED;
+  std::size_t size = 0;
+  Mapping(int fd, std::size_t size_, bool populate) noexcept : size{size_} {
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (populate)
+      flags |= MAP_POPULATE;
+#endif
+    addr = ::mmap(nullptr, size, PROT_READ, flags, fd, 0);
+  }
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+  ~Mapping() { if (addr != MAP_FAILED) ::munmap(addr, size); }
+  explicit operator bool() const noexcept { return (addr != MAP_FAILED); }
+}; // Mapping
+
+/* A file truncated while mapped raises SIGBUS on the first touch of a page
+   past its new end.  Rather than let that kill every other file being
+   summed, the handler jumps back into CrcSumMapped when the fault lies in
+   the mapping the faulting thread is summing; any other SIGBUS is fatal as
+   before.  The kernels hold nothing needing cleanup, so the jump out of
+   one is safe.  */
+thread_local const std::byte* GuardLo = nullptr;
+thread_local const std::byte* GuardHi = nullptr;
+thread_local sigjmp_buf* GuardJmp = nullptr;
+
+extern "C" void OnSigbus(int sig, siginfo_t* info, void*) {
+  auto addr = static_cast<const std::byte*>(info->si_addr);
+  if (GuardJmp && addr >= GuardLo && addr < GuardHi)
+    ::siglongjmp(*GuardJmp, 1);
+  std::signal(sig, SIG_DFL);
+  std::raise(sig);
+} // OnSigbus
+
+void CatchSigbus() noexcept {
+  static const bool once = []() {
+    struct sigaction sa = {};
+    sa.sa_sigaction = OnSigbus;
+    sa.sa_flags = SA_SIGINFO;
+    sigemptyset(&sa.sa_mask);
+    return (::sigaction(SIGBUS, &sa, nullptr) == 0);
+  }();
+  static_cast<void>(once);
+} // CatchSigbus
+
+} // anonymous
+
+/* Checksum a regular file by mapping it and passing the mapped pages straight
+   to the kernel, avoiding the copy into a read buffer.  Pipes, devices and
+   anything that cannot be mapped go through CrcSumStream.  A file truncated
+   while it is summed fails with an error.  */
+
+CrcType CrcSumMapped(const std::filesystem::path& fname,
+                     std::streamsize* length, bool populate)
+{
+  auto fallback = [&]() { return CrcSumFile(fname, length, SumOptions{}); };
+
+  auto file = FileDesc{::open(fname.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (file.fd < 0)
+    throw std::runtime_error{"cannot read"};
+
+  struct stat st;
+  if (::fstat(file.fd, &st) != 0)
+    throw std::system_error{errno, std::generic_category(), "fstat"};
+  if (!S_ISREG(st.st_mode) || st.st_size <= 0)
+    return fallback();
+
+  auto size = static_cast<std::size_t>(st.st_size);
+  auto map = Mapping{file.fd, size, populate};
+  if (!map)
+    return fallback();
+
+  auto bp = static_cast<const std::byte*>(map.addr);
+  ::madvise(map.addr, size, MADV_SEQUENTIAL);
+  ::madvise(map.addr, std::min(size, MapWindow), MADV_WILLNEED);
+
+  auto cksum_fp = CksumKernel();
+  CatchSigbus();
+  sigjmp_buf env;
+  if (sigsetjmp(env, 1) != 0) {
+    GuardJmp = nullptr;
+    throw std::runtime_error{"file shrank while being read"};
+  }
+  GuardLo  = bp;
+  GuardHi  = bp + size;
+  GuardJmp = &env;
+  auto crc = CrcType{0};
+  for (std::size_t off = 0; off < size; off += MapWindow) {
+    auto len = std::min(size - off, MapWindow);
+    auto next = off + len;
+    if (next < size) {
+      ::madvise(const_cast<std::byte*>(bp + next),
+                std::min(size - next, MapWindow), MADV_WILLNEED);
+    }
+    crc = cksum_fp(crc, bp + off, len);
+  }
+  GuardJmp = nullptr;
+
+  if (length)
+    *length = static_cast<std::streamsize>(size);
+
+  return CrcFinal(crc, size);
+} // CrcSumMapped
@@ -0,0 +1,205 @@
+#include "cksum.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <map>
+#include <utility>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+
+#include <sched.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// The first line of a sysfs attribute, or "" if it cannot be read.
+std::string ReadAttr(const fs::path& p) {
+  auto in = std::ifstream{p};
+  auto line = std::string{};
+  std::getline(in, line);
+  return line;
+} // ReadAttr
+
+bool ParseInt(std::string_view s, int* n) {
+  auto [p, ec] = std::from_chars(s.data(), s.data() + s.size(), *n);
+  return (ec == std::errc{} && p == s.data() + s.size());
+} // ParseInt
+
+/// A sysfs CPU list such as "0-3,8-11".
+std::vector<int> ParseCpuList(std::string_view s) {
+  auto cpus = std::vector<int>{};
+  while (!s.empty()) {
+    auto item = s.substr(0, s.find(','));
+    s.remove_prefix(std::min(s.size(), item.size() + 1));
+    auto dash = item.find('-');
+    int lo, hi;
+    if (!ParseInt(item.substr(0, dash), &lo))
+      return {};
+    hi = lo;
+    if (dash != std::string_view::npos
+        && (!ParseInt(item.substr(dash + 1), &hi) || hi < lo))
+      return {};
+    for (auto c = lo; c <= hi; ++c)
+      cpus.push_back(c);
+  }
+  return cpus;
+} // ParseCpuList
+
+struct Node {
+  int id;
+  std::vector<int> cpus;    // those of its CPUs this process may use
+}; // Node
+
+/* The NUMA nodes with CPUs this process may run on, as the process found
+   them on first use, so a later taskset or cgroup limit is respected but
+   pinning done here is not mistaken for one.  A kernel without NUMA shows
+   no node directories; all CPUs then form node 0.  */
+const std::vector<Node>& Nodes() {
+  static const auto nodes = []() {
+    auto allowed = cpu_set_t{};
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+      CPU_ZERO(&allowed);
+    auto usable = [&](std::vector<int> cpus) {
+      std::erase_if(cpus, [&](int c) {
+        return (c < 0 || c >= CPU_SETSIZE || !CPU_ISSET(c, &allowed));
+      });
+      return cpus;
+    };
+    auto v = std::vector<Node>{};
+    auto ec = std::error_code{};
+    for (const auto& e:
+           fs::directory_iterator{"/sys/devices/system/node", ec})
+    {
+      auto name = e.path().filename().string();
+      int id;
+      if (!name.starts_with("node") || !ParseInt(name.substr(4), &id))
+        continue;
+      auto cpus = usable(ParseCpuList(ReadAttr(e.path() / "cpulist")));
+      if (!cpus.empty())
+        v.push_back(Node{id, std::move(cpus)});
+    }
+    if (v.empty()) {
+      auto all = std::vector<int>{};
+      for (int c = 0; c != CPU_SETSIZE; ++c)
+        all.push_back(c);
+      v.push_back(Node{0, usable(std::move(all))});
+    }
+    std::ranges::sort(v, {}, &Node::id);
+    return v;
+  }();
+  return nodes;
+} // Nodes
+
+/* The node of the block device whose sysfs directory is `dir`: that of the
+   nearest ancestor device reporting one, normally the PCI function of the
+   NVMe controller or HBA.  A device-mapper or md device takes the node its
+   member devices share, if they share one.  The walk stops at `root`,
+   where sysfs is mounted.  */
+int SysfsNode(const fs::path& root, const fs::path& dir, int depth = 0) {
+  auto ec = std::error_code{};
+  auto real = fs::canonical(dir, ec);
+  if (ec)
+    return -1;
+  if (auto slaves = real / "slaves";
+      depth < 4 && !fs::is_empty(slaves, ec) && !ec)
+  {
+    int node = -2;
+    for (const auto& e: fs::directory_iterator{slaves, ec}) {
+      auto n = SysfsNode(root, e.path(), depth + 1);
+      if (node != -2 && n != node)
+        return -1;
+      node = n;
+    }
+    return std::max(node, -1);
+  }
+  for (auto p = real; p != root && p.has_relative_path();
+       p = p.parent_path())
+  {
+    auto attr = ReadAttr(p / "numa_node");
+    int node;
+    if (!attr.empty() && ParseInt(attr, &node))
+      return std::max(node, -1);
+  }
+  return -1;
+} // SysfsNode
+
+/// Pin the calling thread to `cpus`; best effort, like every placement here.
+void Pin(std::span<const int> cpus) noexcept {
+  auto set = cpu_set_t{};
+  CPU_ZERO(&set);
+  for (auto c: cpus)
+    CPU_SET(c, &set);
+  ::sched_setaffinity(0, sizeof(set), &set);
+} // Pin
+
+} // anonymous
+
+/* Looked up once per device: every file of a tree usually sits on the same
+   few, and the walk up sysfs costs a few dozen system calls.  */
+
+int DeviceNode(const std::filesystem::path& fname,
+               const std::filesystem::path& sysfs)
+{
+  static auto mtx = std::mutex{};
+  static auto known = std::map<std::pair<fs::path, dev_t>, int>{};
+  struct stat st;
+  if (::stat(fname.c_str(), &st) != 0)
+    return -1;
+  auto dev = S_ISBLK(st.st_mode) ? st.st_rdev : st.st_dev;
+  auto key = std::pair{sysfs, dev};
+  {
+    auto lock = std::lock_guard{mtx};
+    if (auto it = known.find(key); it != known.end())
+      return it->second;
+  }
+  auto ec = std::error_code{};
+  auto root = fs::canonical(sysfs, ec);
+  auto link = root / "dev/block"
+            / (std::to_string(major(dev)) + ':' + std::to_string(minor(dev)));
+  auto node = ec ? -1 : SysfsNode(root, link);
+  auto lock = std::lock_guard{mtx};
+  known.emplace(std::move(key), node);
+  return node;
+} // DeviceNode
+
+/* Each thread takes a slot number the first time it gets here.  A file on a
+   device with a known node is summed there, on the slot'th of its CPUs;
+   otherwise the thread keeps to its home node, the nodes being dealt out
+   round-robin by slot, so that workers spread evenly over the sockets.
+   Once pinned, the buffers a reader allocates and first touches, and the
+   page cache it fills, come from the local node.  A file split over several
+   threads pins to the whole node instead, since the range threads inherit
+   the affinity.  */
+
+void NumaPlace(const std::filesystem::path& fname, const SumOptions& opts) {
+  static auto next = std::atomic<unsigned>{0};
+  thread_local const unsigned slot = next.fetch_add(1);
+  const auto& nodes = Nodes();
+  if (nodes.front().cpus.empty())
+    return;
+
+  auto home = slot % nodes.size();
+  auto turn = slot / nodes.size();
+  if (auto dev = DeviceNode(fname); dev >= 0) {
+    auto it = std::ranges::find(nodes, dev, &Node::id);
+    if (it != nodes.end()) {
+      home = static_cast<std::size_t>(it - nodes.begin());
+      turn = slot;
+    }
+  }
+  const auto& cpus = nodes[home].cpus;
+  if (opts.threads > 1)
+    Pin(cpus);
+  else
+    Pin(std::span{&cpus[turn % cpus.size()], 1});
+} // NumaPlace
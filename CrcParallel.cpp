@@ -0,0 +1,107 @@
+#include "cksum.hpp"
+#include "CrcCombine.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+
+/* Smallest range worth handing to its own thread.  */
+constexpr std::uintmax_t MinRange = 64 * BufLen;
+
+namespace {
+
+struct Part {
+  CrcType crc = CrcType{0};
+  std::uintmax_t length = 0;
+}; // Part
+
+// Checksum `count` bytes of fname starting at `offset`; count == 0 means read
+// to end-of-file.  Each range has its own stream, so ranges never share state.
+Part SumRange(const std::filesystem::path& fname, cksum_fp_t cksum_fp,
+              std::uintmax_t offset, std::uintmax_t count)
+{
+  auto stream = std::ifstream{fname, std::ios::in | std::ios::binary};
+  if (!stream)
+    throw std::runtime_error{"cannot read"};
+  stream.exceptions(std::ios::badbit);
+  stream.seekg(static_cast<std::streamoff>(offset));
+
+  using uint128_t = unsigned __int128;
+  alignas(uint128_t) auto buf = std::array<std::byte, BufLen>{};
+  auto cbuf = reinterpret_cast<char*>(buf.data());
+
+  auto part = Part{};
+  const bool to_eof = (count == 0);
+  while (to_eof || part.length != count) {
+    auto want = BufLen;
+    if (!to_eof)
+      want = static_cast<std::size_t>(std::min<std::uintmax_t>(want,
+                                                      count - part.length));
+    stream.read(cbuf, static_cast<std::streamsize>(want));
+    auto len = static_cast<std::size_t>(stream.gcount());
+    if (len == 0)
+      break;
+    part.crc = cksum_fp(part.crc, buf.data(), len);
+    part.length += len;
+    if (stream.eof())
+      break;
+  }
+  if (!to_eof && part.length != count)
+    throw std::runtime_error{"file shrank while reading"};
+  return part;
+} // SumRange
+
+} // anonymous
+
+/* Split a regular file into contiguous ranges, checksum them concurrently and
+   merge the partial CRCs in file order.  The result is identical to
+   CrcSumStream over the whole file.  */
+
+CrcType CrcSumParallel(const std::filesystem::path& fname,
+                       std::streamsize* length, const SumOptions& opts)
+{
+  namespace fs = std::filesystem;
+  auto ec = std::error_code{};
+  auto size = std::uintmax_t{0};
+  if (fs::is_regular_file(fname, ec))
+    size = fs::file_size(fname, ec);
+  if (ec)
+    size = 0;
+
+  auto ranges = std::min<std::uintmax_t>(opts.threads, size / MinRange);
+  if (ranges < 2) {
+    auto serial = opts;
+    serial.threads = 1;
+    return CrcSumFile(fname, length, serial);
+  }
+
+  // Keep every range but the last a multiple of BufLen.
+  auto step = (size / ranges) / BufLen * BufLen;
+  auto cksum_fp = CksumKernel();
+
+  auto parts = std::vector<std::future<Part>>{};
+  parts.reserve(ranges);
+  for (std::uintmax_t i = 0; i != ranges; ++i) {
+    auto count = (i + 1 == ranges) ? std::uintmax_t{0} : step;
+    parts.push_back(std::async(std::launch::async, SumRange,
+                               std::cref(fname), cksum_fp, i * step, count));
+  }
+
+  auto crc = CrcType{0};
+  auto total_bytes = std::uintmax_t{0};
+  for (auto& f: parts) {
+    auto part = f.get();
+    crc = CrcCombine(crc, part.crc, part.length);
+    total_bytes += part.length;
+  }
+
+  if (length)
+    *length = static_cast<std::streamsize>(total_bytes);
+
+  return CrcFinal(crc, total_bytes);
+} // CrcSumParallel
@@ -0,0 +1,74 @@
+#pragma once
+#include "Int.hpp"
+
+#include <bit>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+namespace tjg::crc {
+
+/* The register continued over n bytes M of a non-reflected CRC is
+   (c*x^(8n) + M*x^W) mod P(x): the message with c xored into its leading W
+   bits, times x^W.  A fold can therefore take the message in 16-byte blocks
+   from the front, the first one short when n is not a multiple of 16, with
+   the register mixed into the first bytes instead of aligning to it.  The
+   short block is assembled from two overlapping loads, so neither a byte
+   loop nor a table lookup is left at either end.  */
+
+/// The n bytes at p, 1 <= n <= 16, as a big-endian number.
+[[gnu::always_inline]]
+inline unsigned __int128 LoadShort(const std::byte* p, std::size_t n) noexcept
+{
+  using uint128_t = unsigned __int128;
+  using std::uint64_t;
+  auto load = [](const std::byte* q, auto x) {
+    auto v = tjg::Int<decltype(x), std::endian::big>{};
+    std::memcpy(&v, q, sizeof(v));
+    return uint64_t{v.value()};
+  };
+  auto low = [](uint64_t x, std::size_t bits)
+    { return x & ((uint64_t{1} << bits) - 1); };
+  if (n >= 8) {
+    auto bits = 8 * (n - 8);
+    auto hi = uint128_t{load(p, uint64_t{})} << bits;
+    auto lo = load(p + n - 8, uint64_t{});
+    return (bits == 64) ? (hi | lo) : (hi | low(lo, bits));
+  }
+  if (n >= 4) {
+    auto bits = 8 * (n - 4);
+    auto hi = load(p, std::uint32_t{}) << bits;
+    return hi | low(load(p + n - 4, std::uint32_t{}), bits);
+  }
+  auto b = [&](std::size_t i) { return std::to_integer<uint64_t>(p[i]); };
+  return (b(0) << 8*(n-1)) | (b(n/2) << 8*(n-1-n/2)) | b(n-1);
+} // LoadShort
+
+/// A fold accumulator started from the first block and the register.
+struct FoldHead {
+  unsigned __int128 acc;    ///< First block with the register mixed in.
+  unsigned __int128 next;   ///< Register bits that fall in the next block.
+}; // FoldHead
+
+/// Start a fold over the first `head` bytes at p, 1 <= head <= 16.  When the
+/// block is shorter than the register, its low bits go to the next block.
+template<typename C>
+[[gnu::always_inline]]
+inline FoldHead StartFold(std::uint64_t crc, const std::byte* p,
+                          std::size_t head) noexcept
+{
+  using uint128_t = unsigned __int128;
+  constexpr int W = C::Bits;
+  const auto bits = int(8 * head);
+  auto h = FoldHead{LoadShort(p, head), 0};
+  if (bits >= W) {
+    h.acc ^= uint128_t{crc} << (bits - W);
+  }
+  else {
+    h.acc  ^= crc >> (W - bits);
+    h.next  = uint128_t{crc & (C::Mask >> bits)} << (128 - W + bits);
+  }
+  return h;
+} // StartFold
+
+} // tjg::crc
@@ -1,4 +1,5 @@
 #include "cksum.hpp"
+#include "CrcEngine.hpp"
 
 #include <chrono>
 #include <vector>
@@ -6,16 +7,36 @@
 #include <map>
 #include <initializer_list>
 #include <span>
+#include <string>
+#include <string_view>
 #include <random>
 #include <concepts>
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <iomanip>
 #include <functional>
+#include <algorithm>
+#include <charconv>
 #include <utility>
 #include <type_traits>
+#include <limits>
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
 #include <cstddef>
 #include <cstdlib>
 
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 using Clock = std::chrono::steady_clock;
 
 constexpr std::size_t DataSize = (1 << 20);
@@ -30,80 +51,702 @@ auto Value(U x) -> typename CoutType<U>::type
 
 using CrcFn = CrcType (*)(CrcType crc, const void* buf, std::size_t size);
 
+/// Every kernel, chained LoopCount times over the first DataSize bytes.
 auto ExpectedCrc = CrcType{0x3e906f85};
 
-std::map<std::string, Clock::duration> Times;;
+/// Time-stamp counter ticks, i.e. reference cycles at the nominal frequency;
+/// zero where there is no such counter.
+static std::uint64_t Ticks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+} // Ticks
+
+/// Receives each measured chain's result so it stays live.
+volatile std::uint64_t Sink;
+
+/// Time-stamp counter frequency in GHz, measured against the steady clock
+/// over about 50 ms; zero where there is no such counter.
+static double TscGhz() {
+  if (Ticks() == 0)
+    return 0;
+  auto t0 = Clock::now();
+  auto c0 = Ticks();
+  auto t1 = t0;
+  while (t1 - t0 < std::chrono::milliseconds{50})
+    t1 = Clock::now();
+  auto c1 = Ticks();
+  return double(c1 - c0) / double(std::chrono::nanoseconds{t1 - t0}.count());
+} // TscGhz
+
+/* Hardware event counts for this thread from perf_event_open, read as one
+   group so that every count covers the same instructions.  Only user mode
+   is counted, which perf_event_paranoid 2 still allows.  An event the PMU
+   lacks, as LLC misses often are under a hypervisor, stays absent (NaN);
+   without a cycle counter there are no counters at all.  A group time-shared
+   with other users of the PMU is scaled by the fraction of time it ran.  */
+class PerfCounters {
+public:
+  enum Event { Cycles, Instructions, L1dMisses, LlcMisses, BranchMisses,
+               NumEvents };
+  using Counts  = std::array<double, NumEvents>;
+  using Reading = std::array<std::uint64_t, 3 + NumEvents>;
+
+  PerfCounters() { _slot.fill(-1); }
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  ~PerfCounters() {
+    for (auto fd: _fds)
+      ::close(fd);
+  }
+
+  bool active() const noexcept { return !_fds.empty(); }
+  bool has(Event e) const noexcept { return _slot[e] >= 0; }
+
+  /// Open and start the group; false, with errno set, if cycles cannot be
+  /// counted.
+  bool open() {
+    constexpr auto Miss = [](std::uint64_t cache) {
+      return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                   | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    };
+    constexpr std::pair<std::uint32_t, std::uint64_t> Spec[NumEvents] = {
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HW_CACHE, Miss(PERF_COUNT_HW_CACHE_L1D)},
+      {PERF_TYPE_HW_CACHE, Miss(PERF_COUNT_HW_CACHE_LL)},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+    for (int e = 0; e != NumEvents; ++e) {
+      auto attr = perf_event_attr{};
+      attr.size   = sizeof(attr);
+      attr.type   = Spec[e].first;
+      attr.config = Spec[e].second;
+      attr.disabled       = (e == Cycles);
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                       | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      auto leader = _fds.empty() ? -1 : _fds.front();
+      auto fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1,
+                                           leader, PERF_FLAG_FD_CLOEXEC));
+      if (fd < 0) {
+        if (e == Cycles)
+          return false;
+        continue;
+      }
+      _slot[e] = static_cast<int>(_fds.size());
+      _fds.push_back(fd);
+    }
+    ::ioctl(_fds.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(_fds.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+  } // open
+
+  /// The group's running totals: count, time enabled, time running, values.
+  Reading read() const noexcept {
+    auto r = Reading{};
+    if (active() && ::read(_fds.front(), r.data(), sizeof(r)) <= 0)
+      r.fill(0);
+    return r;
+  }
+
+  /// Events since `start`, scaled for time-sharing; all NaN if the group
+  /// never ran.
+  Counts since(const Reading& start) const noexcept {
+    auto r = read();
+    auto c = Counts{};
+    c.fill(std::numeric_limits<double>::quiet_NaN());
+    auto enabled = double(r[1] - start[1]);
+    auto running = double(r[2] - start[2]);
+    if (running <= 0)
+      return c;
+    for (int e = 0; e != NumEvents; ++e) {
+      if (has(Event(e))) {
+        auto i = 3 + std::size_t(_slot[e]);
+        c[e] = double(r[i] - start[i]) * enabled / running;
+      }
+    }
+    return c;
+  } // since
+
+private:
+  std::vector<int> _fds;
+  std::array<int, NumEvents> _slot;
+}; // PerfCounters
+
+/// The counters Measure reads around each sample, when opened.
+PerfCounters Perf;
+
+struct Options {
+  std::vector<std::size_t> sizes;
+  std::vector<std::size_t> aligns{0};
+  std::vector<std::string> only;          // bench names; empty for all
+  double budget    = 0.2;                 // seconds per matrix point
+  double threshold = 5.0;                 // percent slower than baseline
+  std::string json;
+  std::string baseline;
+  bool counters    = false;               // read hardware counters
+}; // Options
 
-bool TestCrc(CrcFn fn, const std::string name, std::span<const std::byte> data)
+/* Robust per-call statistics for one matrix point.  Interference
+   (interrupts, migrations, frequency steps) only ever slows a sample down,
+   so samples slower than the median by more than five scaled median
+   absolute deviations, and by more than 5% of the median, are dropped
+   before the median is taken; the 5% floor keeps clock quantization of a
+   tight distribution from counting as outliers.  The minimum and p99 are
+   taken over every sample, so the tail stays visible, and `rejected` says
+   how many the median left out.  */
+struct Stats {
+  std::size_t samples  = 0;
+  std::size_t rejected = 0;
+  double median = 0;    // ns per call
+  double p99    = 0;
+  double min    = 0;
+  double ticks  = 0;    // median Ticks() per call
+  PerfCounters::Counts events{};    // median events per call
+}; // Stats
+
+static Stats Summarize(std::vector<double> ns, std::vector<double> ticks,
+                       const std::vector<PerfCounters::Counts>& events)
 {
-  using namespace std;
-  using namespace std::chrono;
-  // cout << "Running " << left << setw(8) << name << right << "... ";
-  auto start = Clock::now();
-  auto crc = CrcType{0};
-  for (int i = 0; i != LoopCount; ++i)
-    crc = fn(crc, data.data(), data.size());
-  auto stop = Clock::now();
-  Times[name] += (stop - start);
-#if 0
-  auto s = duration<double>(stop - start);
-  auto rate = static_cast<double>(data.size() * LoopCount)
-            / DataSize / s.count();
-  cout << hex << setfill('0') << " 0x" << setw(8) << crc
-    << dec << setfill(' ') << fixed << setprecision(0)
-    << ' ' << setw(8) << rate << "MiB/s";
-  if (ExpectedCrc == CrcType{0})
-    ExpectedCrc = crc;
-  if (crc != ExpectedCrc)
-    cout << " FAIL";
-  cout << endl;
-#endif
-  return (crc == ExpectedCrc);
-} // TestCrc
+  auto median = [](std::vector<double>& v) {
+    std::ranges::sort(v);
+    auto n = v.size();
+    return (n % 2) ? v[n/2] : (v[n/2 - 1] + v[n/2]) / 2;
+  };
+  auto s = Stats{};
+  s.ticks = median(ticks);
+  for (std::size_t e = 0; e != s.events.size(); ++e) {
+    auto v = std::vector<double>{};
+    for (const auto& c: events)
+      v.push_back(c[e]);
+    s.events[e] = v.empty() ? std::numeric_limits<double>::quiet_NaN()
+                            : median(v);
+  }
+  auto m = median(ns);
+  auto dev = std::vector<double>{};
+  for (auto x: ns)
+    dev.push_back(std::abs(x - m));
+  const auto limit = m + std::max(5 * 1.4826 * median(dev), m / 20);
+  s.min     = ns.front();
+  auto rank = static_cast<std::size_t>(std::ceil(0.99 * double(ns.size())));
+  s.p99     = ns[std::max<std::size_t>(rank, 1) - 1];
+  s.rejected = std::erase_if(ns, [&](double x) { return x > limit; });
+  s.samples = ns.size();
+  s.median  = median(ns);
+  return s;
+} // Summarize
+
+/* Time fn over `size` bytes at buf.  The repetition count per sample doubles
+   until a sample is long enough for the clock, which doubles as the start of
+   the warmup; warmup then continues for a tenth of the budget.  The rest of
+   the budget is split into between 5 and 201 samples.  Each call is chained
+   to the previous result so the compiler cannot hoist or drop it.  Counters
+   are read outside the timed interval, so their system calls cost time but
+   add only a few hundred user instructions to a sample.  */
+template<typename Fn>
+Stats Measure(Fn fn, const std::byte* buf, std::size_t size, double budget) {
+  using Secs = std::chrono::duration<double>;
+  constexpr auto MinSample = Secs{20e-6};
+  auto v = std::uint64_t{0};
+  auto events = std::vector<PerfCounters::Counts>{};
+  auto sample = [&](std::size_t reps) {
+    auto p0 = Perf.read();
+    auto t0 = Clock::now();
+    auto c0 = Ticks();
+    for (std::size_t i = 0; i != reps; ++i)
+      v = fn(v, buf, size);
+    auto c1 = Ticks();
+    auto t1 = Clock::now();
+    if (Perf.active())
+      events.push_back(Perf.since(p0));
+    return std::pair{Secs{t1 - t0}, c1 - c0};
+  };
+
+  auto reps = std::size_t{1};
+  auto dt = sample(reps).first;
+  for ( ; dt < MinSample; dt = sample(reps).first)
+    reps *= 2;
+  for (auto warm = dt; warm.count() < budget / 10; warm += sample(reps).first)
+    ;
+  events.clear();
+
+  auto count = static_cast<std::size_t>(budget / dt.count());
+  count = std::clamp<std::size_t>(count, 5, 201);
+  auto ns    = std::vector<double>{};
+  auto ticks = std::vector<double>{};
+  for (std::size_t i = 0; i != count; ++i) {
+    auto [t, c] = sample(reps);
+    ns.push_back(1e9 * t.count() / double(reps));
+    ticks.push_back(double(c) / double(reps));
+    if (!events.empty()) {
+      for (auto& x: events.back())
+        x /= double(reps);
+    }
+  }
+  Sink = v;
+  return Summarize(std::move(ns), std::move(ticks), events);
+} // Measure
+
+/* One benchmarked function.  `value` gives the raw CRC of a buffer, which
+   must match that of the `ref` bench at every matrix point; `time` runs
+   Measure with the concrete function so the timed loop has no extra
+   indirection.  */
+struct Bench {
+  std::string name;
+  std::string ref;
+  std::function<std::uint64_t(const void*, std::size_t)> value;
+  std::function<Stats(const std::byte*, std::size_t, double)> time;
+  std::size_t count = 1;    // buffers per call; times are per buffer
+}; // Bench
+
+static Bench KernelBench(const KernelInfo& k) {
+  auto fn = [f = k.fn](std::uint64_t crc, const void* buf, std::size_t size)
+    { return std::uint64_t{f(CrcType(crc), buf, size)}; };
+  return Bench{ k.name, "slice8",
+      [fn](const void* buf, std::size_t size) { return fn(0, buf, size); },
+      [fn](const std::byte* buf, std::size_t size, double budget)
+        { return Measure(fn, buf, size, budget); } };
+} // KernelBench
+
+/* Batches of BatchCount independent buffers laid end to end, their lengths
+   ragged by up to a quarter either side of `size` but averaging it.  The
+   batch kernel and a loop over the single-buffer kernel see the same
+   buffers; the first continues the chained value and the result is the xor
+   of all of them.  */
+constexpr std::size_t BatchCount = 64;
+
+static std::size_t BatchExtent(std::size_t size) noexcept
+  { return BatchCount * (size + size / 4); }
+
+static std::array<CrcBuffer, BatchCount> BatchBuffers(const std::byte* buf,
+                                                      std::size_t size) noexcept
+{
+  const auto d = size / 4;
+  const std::array<std::size_t, 4> len{size - d, size + d,
+                                       size - d/2, size + d/2};
+  auto bufs = std::array<CrcBuffer, BatchCount>{};
+  for (std::size_t i = 0; i != BatchCount; ++i)
+    bufs[i] = CrcBuffer{buf + i * (size + d), len[i % len.size()]};
+  return bufs;
+} // BatchBuffers
+
+template<bool Batch>
+Bench BatchBench() {
+  auto fn = [](std::uint64_t crc, const void* buf, std::size_t size) {
+    auto bufs = BatchBuffers(static_cast<const std::byte*>(buf), size);
+    auto crcs = std::array<CrcType, BatchCount>{};
+    crcs[0] = CrcType(crc);
+    if constexpr (Batch) {
+      cksum_batch(bufs, crcs);
+    }
+    else {
+      auto cksum_fp = CksumKernel();
+      for (std::size_t i = 0; i != BatchCount; ++i)
+        crcs[i] = cksum_fp(crcs[i], bufs[i].data(), bufs[i].size());
+    }
+    auto v = std::uint64_t{0};
+    for (auto c: crcs)
+      v ^= c;
+    return v;
+  };
+  return Bench{ Batch ? "batch" : "batch-loop", "batch-loop",
+      [fn](const void* buf, std::size_t size) { return fn(0, buf, size); },
+      [fn](const std::byte* buf, std::size_t size, double budget) {
+        auto s = Measure(fn, buf, size, budget);
+        for (auto x: {&s.median, &s.p99, &s.min, &s.ticks})
+          *x /= BatchCount;
+        for (auto& x: s.events)
+          x /= BatchCount;
+        return s;
+      },
+      BatchCount };
+} // BatchBench
+
+template<typename P, auto Update>
+Bench EngineBench(const std::string& name, const std::string& kname) {
+  auto fn = [](std::uint64_t crc, const void* buf, std::size_t size)
+    { return std::uint64_t{Update(tjg::crc::CrcValue<P>(crc), buf, size)}; };
+  return Bench{ name + '/' + kname, name + "/slice8",
+      [fn](const void* buf, std::size_t size)
+        { return fn(P::Init, buf, size); },
+      [fn](const std::byte* buf, std::size_t size, double budget)
+        { return Measure(fn, buf, size, budget); } };
+} // EngineBench
+
+/* Add the generic engine's kernels for parameter set P after checking the
+   table kernel against the catalogue check value for "123456789".  */
+template<typename P>
+bool AddEngine(std::vector<Bench>* benches, const std::string& name,
+               tjg::crc::CrcValue<P> check)
+{
+  namespace crc = tjg::crc;
+  constexpr auto CheckStr = std::string_view{"123456789"};
+  benches->push_back(EngineBench<P, crc::UpdateSlice<P>>(name, "slice8"));
+  benches->push_back(EngineBench<P, crc::UpdateInterleaved<P>>(name, "multi"));
+  if (crc::FoldSupported())
+    benches->push_back(EngineBench<P, crc::UpdateFold<P>>(name, "fold"));
+  return (crc::Finalize<P>(crc::UpdateSlice<P>(P::Init, CheckStr.data(),
+                                                CheckStr.size())) == check);
+} // AddEngine
+
+/// Chain every cksum kernel over the first DataSize bytes.
+static int TestKernels(std::span<const std::byte> data) {
+  int failed = 0;
+  for (const auto& k: CksumKernels()) {
+    if (!k.supported())
+      continue;
+    auto crc = CrcType{0};
+    for (int i = 0; i != LoopCount; ++i)
+      crc = k.fn(crc, data.data(), data.size());
+    if (crc != ExpectedCrc) {
+      std::cout << k.name << ": FAIL\n";
+      ++failed;
+    }
+  }
+  return failed;
+} // TestKernels
+
+/// A decimal count with an optional binary K, M or G suffix.
+static bool ParseSize(std::string_view s, std::size_t* n) {
+  auto [p, ec] = std::from_chars(s.data(), s.data() + s.size(), *n);
+  if (ec != std::errc{})
+    return false;
+  auto rest = std::string_view{p, s.data() + s.size()};
+  if (rest.empty())
+    return true;
+  if (rest.size() != 1)
+    return false;
+  auto shift = std::string_view{"KMG"}.find(rest[0]);
+  if (shift == std::string_view::npos)
+    return false;
+  *n <<= 10 * (shift + 1);
+  return true;
+} // ParseSize
+
+/// Comma-separated sizes or inclusive ranges "a-b".
+static bool ParseList(std::string_view s, std::vector<std::size_t>* v) {
+  v->clear();
+  while (!s.empty()) {
+    auto item = s.substr(0, s.find(','));
+    s.remove_prefix(std::min(s.size(), item.size() + 1));
+    auto dash = item.find('-');
+    std::size_t lo, hi;
+    if (!ParseSize(item.substr(0, dash), &lo))
+      return false;
+    hi = lo;
+    if (dash != std::string_view::npos
+        && (!ParseSize(item.substr(dash + 1), &hi) || hi < lo))
+      return false;
+    for (auto n = lo; n <= hi; ++n)
+      v->push_back(n);
+  }
+  return !v->empty();
+} // ParseList
+
+static bool ParseNumber(std::string_view s, double* x) {
+  auto [p, ec] = std::from_chars(s.data(), s.data() + s.size(), *x);
+  return (ec == std::errc{} && p == s.data() + s.size() && *x > 0);
+} // ParseNumber
+
+static int Usage() {
+  std::cerr << "usage: CrcTime [--sizes=LIST | --short] [--align=LIST]"
+               " [--only=NAMES] [--time=SECONDS]\n"
+               "               [--json=FILE] [--baseline=FILE]"
+               " [--threshold=PERCENT] [--counters]\n"
+               "  LIST is comma-separated sizes (K, M, G suffixes) or"
+               " ranges a-b;\n"
+               "  sizes default to powers of 4 from 1 B to 4 MiB; larger"
+               " ones, such as 1G,\n"
+               "  need --sizes.  --short takes every length from 1 to 256."
+               "  Calls are\n"
+               "  chained, so short sizes give latency.\n"
+               "  --counters adds core cycles/byte, IPC, clock, and L1D and"
+               " LLC read and\n"
+               "  branch misses from perf_event_open.\n";
+  return EXIT_FAILURE;
+} // Usage
+
+/// The string or number following "key": in a single-line JSON object.
+static std::string_view Field(std::string_view line, std::string_view key) {
+  auto tag = std::string{'"'} + std::string{key} + "\":";
+  auto pos = line.find(tag);
+  if (pos == std::string_view::npos)
+    return {};
+  line.remove_prefix(pos + tag.size());
+  while (!line.empty() && line.front() == ' ')
+    line.remove_prefix(1);
+  if (line.starts_with('"')) {
+    line.remove_prefix(1);
+    return line.substr(0, line.find('"'));
+  }
+  return line.substr(0, line.find_first_of(",}"));
+} // Field
+
+struct Point {
+  std::string name;
+  std::size_t size;
+  std::size_t align;
+  auto operator<=>(const Point&) const = default;
+}; // Point
+
+/// Median ns per call by point, from a file written by --json.
+static bool ReadBaseline(const std::string& path,
+                         std::map<Point, double>* base)
+{
+  auto in = std::ifstream{path};
+  if (!in)
+    return false;
+  for (std::string line; std::getline(in, line); ) {
+    auto name = Field(line, "name");
+    auto size = Field(line, "size");
+    auto align = Field(line, "align");
+    auto median = Field(line, "median_ns");
+    if (name.empty() || size.empty() || align.empty() || median.empty())
+      continue;
+    auto pt = Point{std::string{name}, 0, 0};
+    auto ns = 0.0;
+    if (ParseSize(size, &pt.size) && ParseSize(align, &pt.align)
+        && ParseNumber(median, &ns))
+      (*base)[pt] = ns;
+  }
+  return true;
+} // ReadBaseline
+
+int main(int argc, const char* argv[]) {
+  using namespace std::literals;
+  auto opts = Options{};
+  for (std::size_t n = 1; n <= (std::size_t{4} << 20); n *= 4)
+    opts.sizes.push_back(n);
+  for (int i = 1; i != argc; ++i) {
+    auto arg = std::string_view{argv[i]};
+    if (arg.starts_with("--sizes="sv)) {
+      if (!ParseList(arg.substr(8), &opts.sizes)
+          || std::ranges::count(opts.sizes, 0) != 0)
+        return Usage();
+    }
+    else if (arg == "--short"sv) {
+      opts.sizes.clear();
+      for (std::size_t n = 1; n <= 256; ++n)
+        opts.sizes.push_back(n);
+    }
+    else if (arg.starts_with("--align="sv)) {
+      if (!ParseList(arg.substr(8), &opts.aligns)
+          || std::ranges::max(opts.aligns) >= 64)
+        return Usage();
+    }
+    else if (arg.starts_with("--only="sv)) {
+      auto s = arg.substr(7);
+      while (!s.empty()) {
+        auto item = s.substr(0, s.find(','));
+        s.remove_prefix(std::min(s.size(), item.size() + 1));
+        opts.only.emplace_back(item);
+      }
+    }
+    else if (arg.starts_with("--time="sv)) {
+      if (!ParseNumber(arg.substr(7), &opts.budget))
+        return Usage();
+    }
+    else if (arg.starts_with("--json="sv)) {
+      opts.json = arg.substr(7);
+    }
+    else if (arg.starts_with("--baseline="sv)) {
+      opts.baseline = arg.substr(11);
+    }
+    else if (arg.starts_with("--threshold="sv)) {
+      if (!ParseNumber(arg.substr(12), &opts.threshold))
+        return Usage();
+    }
+    else if (arg == "--counters"sv) {
+      opts.counters = true;
+    }
+    else {
+      return Usage();
+    }
+  }
 
-int main() {
+  auto base = std::map<Point, double>{};
+  if (!opts.baseline.empty() && !ReadBaseline(opts.baseline, &base)) {
+    std::cerr << "CrcTime: cannot read " << opts.baseline << '\n';
+    return EXIT_FAILURE;
+  }
+
+  // The first DataSize bytes are those the expected CRC was taken over.
+  const auto maxSize = std::max(DataSize, std::ranges::max(opts.sizes));
   constexpr auto Seed = 12345;
   std::mt19937 rng{Seed};
+  std::cerr << "Generating " << maxSize << " random bytes " << std::flush;
+  auto storage = std::vector<std::byte>(maxSize + 128);
+  auto data = storage.data() + (64 - reinterpret_cast<std::uintptr_t>(
+                                                      storage.data()) % 64);
+  for (std::size_t i = 0; i != maxSize + 63; ++i)
+    data[i] = std::byte(rng() & 0xff);
+  std::cerr << "done." << std::endl;
 
-  std::cerr << "Generating " << DataSize << " random bytes " << std::flush;
-  // Fill data with pseudo-random bytes
-  std::vector<std::byte> data;
-  {
-    rng.seed(Seed);
-    data.reserve(DataSize);
-    for (int i = 0; i != DataSize; ++i)
-      data.push_back(std::byte(rng() & 0xff));
+  int failed = TestKernels(std::span{data, DataSize});
+
+  const auto tscGhz = TscGhz();
+  if (opts.counters && !Perf.open()) {
+    std::cerr << "CrcTime: no hardware counters: " << std::strerror(errno)
+              << '\n';
   }
-  std::cerr << "done." << std::endl;
 
-  int failed = 0;
+  auto benches = std::vector<Bench>{};
+  for (const auto& k: CksumKernels()) {
+    if (k.supported())
+      benches.push_back(KernelBench(k));
+  }
+  if (tjg::crc::FoldSupported()) {
+    benches.push_back(BatchBench<false>());
+    benches.push_back(BatchBench<true>());
+  }
+  using namespace tjg::crc;
+  failed += !AddEngine<Crc32Cksum>(&benches, "cksum",   0x765e7680);
+  failed += !AddEngine<Crc32Gzip> (&benches, "crc32",   0xcbf43926);
+  failed += !AddEngine<Crc32C>    (&benches, "crc32c",  0xe3069283);
+  failed += !AddEngine<Crc64Xz>   (&benches, "crc64xz", 0x995dc9bbdf1939fa);
+  auto index = std::map<std::string, std::size_t>{};
+  for (std::size_t i = 0; i != benches.size(); ++i)
+    index[benches[i].name] = i;
 
-  constexpr int loops = 30;
-  for (int i = 0; i != loops; ++i) {
-    failed += !TestCrc(cksum_slice8 , "Slice8" , std::span{data});
-#ifdef USE_VMULL_CRC32
-    failed += !TestCrc(cksum_simd   , "Simd"   , std::span{data});
-    failed += !TestCrc(cksum_vmull0 , "Vmull0" , std::span{data});
-#endif
-#ifdef USE_PCLMUL_CRC32
-    failed += !TestCrc(cksum_simd   , "Simd"   , std::span{data});
-    failed += !TestCrc(cksum_pclmul0, "PclMul0", std::span{data});
-#endif
+  auto json = std::ostringstream{};
+  json << std::fixed;
+  json << "{\n  \"tool\": \"CrcTime\",\n  \"tsc_ghz\": ";
+  if (tscGhz != 0)
+    json << std::setprecision(3) << tscGhz;
+  else
+    json << "null";
+  json << ",\n  \"results\": [";
+  auto sep = "\n";
+  int regressed = 0;
+  const bool haveTicks = (tscGhz != 0);
+
+  // cyc/B counts TSC reference cycles; core c/B counts those at the clock
+  // the kernel actually ran at, which GHz gives.
+  using Ev = PerfCounters::Event;
+  if (haveTicks)
+    std::cout << "TSC " << std::fixed << std::setprecision(3) << tscGhz
+              << " GHz\n";
+  std::cout << std::left << std::setw(16) << "name" << std::right
+            << std::setw(11) << "size" << std::setw(6) << "align"
+            << std::setw(10) << "MiB/s" << std::setw(12) << "median ns"
+            << std::setw(12) << "p99 ns" << std::setw(8) << "cyc/B"
+            << std::setw(10) << "kept-rej";
+  if (Perf.active()) {
+    std::cout << std::setw(9) << "core c/B" << std::setw(6) << "IPC"
+              << std::setw(6) << "GHz" << std::setw(9) << "L1m/KiB"
+              << std::setw(9) << "LLCm/KiB" << std::setw(9) << "brm/call";
   }
+  std::cout << '\n';
+  for (auto size: opts.sizes) {
+    for (auto align: opts.aligns) {
+      const auto buf = data + align;
+      auto refs = std::map<std::string, std::uint64_t>{};
+      for (const auto& b: benches) {
+        if (!opts.only.empty() && std::ranges::count(opts.only, b.name) == 0)
+          continue;
+        if (b.count != 1 && align + BatchExtent(size) > maxSize + 63)
+          continue;
+        if (!refs.contains(b.ref))
+          refs[b.ref] = benches[index.at(b.ref)].value(buf, size);
+        if (b.value(buf, size) != refs[b.ref]) {
+          std::cout << b.name << ": FAIL at size " << size
+                    << " align " << align << '\n';
+          ++failed;
+          continue;
+        }
+        auto s = b.time(buf, size, opts.budget);
+        auto rate = double(size) / s.median * 1e9 / (1 << 20);
+        auto cpb = haveTicks ? s.ticks / double(size) : 0.0;
 
-  for (const auto& [name, dt]: Times) {
-    using namespace std;
-    auto s = chrono::duration<double>(dt);
-    auto rate = static_cast<double>(data.size() * LoopCount * loops)
-              / DataSize / s.count();
-    cout << left << setw(8) << name << right
-         << fixed << setprecision(0) << ' ' << setw(8) << rate << " MiB/s\n";
+        using namespace std;
+        cout << left << setw(16) << b.name << right << setw(11) << size
+             << setw(6) << align << fixed << setprecision(0) << setw(10)
+             << rate << setprecision(1) << setw(12) << s.median << setw(12)
+             << s.p99 << setprecision(2) << setw(8) << cpb << setw(6)
+             << s.samples << '-' << left << setw(3) << s.rejected << right;
+        const auto& ev = s.events;
+        auto perKiB = [&](Ev e) { return ev[e] * 1024 / double(size); };
+        auto column = [&](int width, int prec, double x) {
+          if (std::isnan(x))
+            cout << setw(width) << '-';
+          else
+            cout << setprecision(prec) << setw(width) << x;
+        };
+        if (Perf.active()) {
+          column(9, 2, ev[Ev::Cycles] / double(size));
+          column(6, 2, ev[Ev::Instructions] / ev[Ev::Cycles]);
+          column(6, 2, ev[Ev::Cycles] / s.median);
+          column(9, 2, perKiB(Ev::L1dMisses));
+          column(9, 2, perKiB(Ev::LlcMisses));
+          column(9, 3, ev[Ev::BranchMisses]);
+        }
+        auto it = base.find(Point{b.name, size, align});
+        if (it != base.end()) {
+          auto change = 100 * (s.median / it->second - 1);
+          cout << showpos << setprecision(1) << ' ' << change << '%'
+               << noshowpos;
+          if (change > opts.threshold) {
+            cout << " REGRESSION";
+            ++regressed;
+          }
+        }
+        cout << '\n';
+
+        json << sep << "    {\"name\": \"" << b.name << "\", \"size\": "
+             << size << ", \"align\": " << align << ", \"samples\": "
+             << s.samples << ", \"rejected\": " << s.rejected
+             << setprecision(3) << ", \"median_ns\": " << s.median
+             << ", \"p99_ns\": " << s.p99 << ", \"min_ns\": " << s.min
+             << ", \"mib_per_s\": " << rate;
+        auto field = [&](const char* key, double x) {
+          json << ", \"" << key << "\": ";
+          if (std::isnan(x))
+            json << "null";
+          else
+            json << setprecision(4) << x;
+        };
+        field("cycles_per_byte", haveTicks ? cpb : std::nan(""));
+        if (Perf.active()) {
+          field("core_cycles_per_byte", ev[Ev::Cycles] / double(size));
+          field("ipc", ev[Ev::Instructions] / ev[Ev::Cycles]);
+          field("core_ghz", ev[Ev::Cycles] / s.median);
+          field("l1d_misses", ev[Ev::L1dMisses]);
+          field("llc_misses", ev[Ev::LlcMisses]);
+          field("branch_misses", ev[Ev::BranchMisses]);
+        }
+        json << '}';
+        sep = ",\n";
+      }
+    }
+  }
+  json << "\n  ]\n}\n";
+
+  if (!opts.json.empty()) {
+    if (opts.json == "-") {
+      std::cout << json.str();
+    }
+    else {
+      auto out = std::ofstream{opts.json};
+      out << json.str();
+      if (!out) {
+        std::cerr << "CrcTime: cannot write " << opts.json << '\n';
+        return EXIT_FAILURE;
+      }
+    }
   }
 
+  if (regressed != 0) {
+    std::cout << '\n' << regressed << " points regressed more than "
+              << opts.threshold << "% against " << opts.baseline << ".\n";
+  }
   if (failed != 0) {
     std::cout << "\nFailed " << failed << " tests.\n";
     return EXIT_FAILURE;
   }
 
-  return EXIT_SUCCESS;
+  return (regressed != 0) ? EXIT_FAILURE : EXIT_SUCCESS;
 } // main
@@ -1,14 +1,17 @@
 #pragma once
-#include <bit>
+#include "CrcEngine.hpp"
+
 #include <cstdint>
 #include <cstddef>
 
-extern const std::uint32_t CrcTab[8][256];
-
 using CrcType = std::uint32_t;
 
+// Generated at compile time, native byte order.
+inline constexpr const auto& CrcTab =
+                              tjg::crc::CrcTables<tjg::crc::Crc32Cksum>;
+
 inline CrcType Lookup(std::byte x) noexcept
-  { return std::byteswap(CrcTab[0][std::to_integer<int>(x)]); }
+  { return CrcTab[0][std::to_integer<int>(x)]; }
 
 inline CrcType CrcUpdate(CrcType crc, std::byte b) noexcept {
   constexpr auto BitsPerByte = 8;
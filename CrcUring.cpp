@@ -0,0 +1,309 @@
+#include "cksum.hpp"
+#include "FileDesc.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <cerrno>
+#include <cstdlib>
+#include <cstdint>
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// Minimal io_uring wrapper over the raw system calls, so no liburing is
+// needed.  Only what an in-order reader requires: queue, submit, wait.
+class Ring {
+  int _fd = -1;
+  io_uring_params _p{};
+  void* _sq = MAP_FAILED;
+  void* _cq = MAP_FAILED;
+  std::size_t _sq_size = 0;
+  std::size_t _cq_size = 0;
+  io_uring_sqe* _sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  std::size_t _sqes_size = 0;
+  unsigned* _sq_tail  = nullptr;
+  unsigned* _sq_mask  = nullptr;
+  unsigned* _sq_array = nullptr;
+  unsigned* _cq_head  = nullptr;
+  unsigned* _cq_tail  = nullptr;
+  unsigned* _cq_mask  = nullptr;
+  io_uring_cqe* _cqes = nullptr;
+  unsigned _pending = 0;
+
+  template<typename T>
+  static T* At(void* base, unsigned off) noexcept
+    { return reinterpret_cast<T*>(static_cast<char*>(base) + off); }
+
+public:
+  explicit Ring(unsigned entries) noexcept {
+    _fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &_p));
+    if (_fd < 0)
+      return;
+    _sq_size = _p.sq_off.array + _p.sq_entries * sizeof(unsigned);
+    _cq_size = _p.cq_off.cqes  + _p.cq_entries * sizeof(io_uring_cqe);
+    if (_p.features & IORING_FEAT_SINGLE_MMAP)
+      _sq_size = _cq_size = std::max(_sq_size, _cq_size);
+    _sq = ::mmap(nullptr, _sq_size, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+    if (_sq == MAP_FAILED)
+      return;
+    if (_p.features & IORING_FEAT_SINGLE_MMAP) {
+      _cq = _sq;
+    }
+    else {
+      _cq = ::mmap(nullptr, _cq_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+      if (_cq == MAP_FAILED)
+        return;
+    }
+    _sqes_size = _p.sq_entries * sizeof(io_uring_sqe);
+    _sqes = static_cast<io_uring_sqe*>(
+              ::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES));
+    _sq_tail  = At<unsigned>(_sq, _p.sq_off.tail);
+    _sq_mask  = At<unsigned>(_sq, _p.sq_off.ring_mask);
+    _sq_array = At<unsigned>(_sq, _p.sq_off.array);
+    _cq_head  = At<unsigned>(_cq, _p.cq_off.head);
+    _cq_tail  = At<unsigned>(_cq, _p.cq_off.tail);
+    _cq_mask  = At<unsigned>(_cq, _p.cq_off.ring_mask);
+    _cqes     = At<io_uring_cqe>(_cq, _p.cq_off.cqes);
+  }
+
+  Ring(const Ring&) = delete;
+  Ring& operator=(const Ring&) = delete;
+
+  ~Ring() {
+    if (_sqes != MAP_FAILED) ::munmap(_sqes, _sqes_size);
+    if (_cq != MAP_FAILED && _cq != _sq) ::munmap(_cq, _cq_size);
+    if (_sq != MAP_FAILED) ::munmap(_sq, _sq_size);
+    if (_fd >= 0) ::close(_fd);
+  }
+
+  /// Reads queued but not yet seen by the kernel.
+  unsigned pending() const noexcept { return _pending; }
+
+  explicit operator bool() const noexcept
+    { return (_fd >= 0 && _sq != MAP_FAILED && _cq != MAP_FAILED
+              && _sqes != MAP_FAILED); }
+
+  bool RegisterBuffers(const iovec* iov, unsigned n) noexcept {
+    return (::syscall(__NR_io_uring_register, _fd,
+                      IORING_REGISTER_BUFFERS, iov, n) == 0);
+  }
+
+  // Queue a fixed-buffer read; it is not seen by the kernel until Submit().
+  void ReadFixed(int fd, void* buf, unsigned len, std::uint64_t offset,
+                 unsigned buf_index, std::uint64_t user_data) noexcept
+  {
+    auto tail = *_sq_tail;
+    auto idx  = tail & *_sq_mask;
+    auto& sqe = _sqes[idx];
+    sqe = io_uring_sqe{};
+    sqe.opcode    = IORING_OP_READ_FIXED;
+    sqe.fd        = fd;
+    sqe.addr      = reinterpret_cast<std::uint64_t>(buf);
+    sqe.len       = len;
+    sqe.off       = offset;
+    sqe.buf_index = static_cast<std::uint16_t>(buf_index);
+    sqe.user_data = user_data;
+    _sq_array[idx] = idx;
+    std::atomic_ref<unsigned>{*_sq_tail}.store(tail + 1,
+                                               std::memory_order_release);
+    ++_pending;
+  }
+
+  void Submit() {
+    while (_pending != 0) {
+      auto rv = ::syscall(__NR_io_uring_enter, _fd, _pending, 0, 0,
+                          nullptr, 0);
+      if (rv < 0) {
+        if (errno == EINTR)
+          continue;
+        throw std::system_error{errno, std::generic_category(),
+                                "io_uring_enter"};
+      }
+      _pending -= static_cast<unsigned>(rv);
+    }
+  }
+
+  // Block until one completion is available and consume it.
+  io_uring_cqe Wait() {
+    for (;;) {
+      auto head = *_cq_head;
+      auto tail = std::atomic_ref<unsigned>{*_cq_tail}
+                                         .load(std::memory_order_acquire);
+      if (head != tail) {
+        auto cqe = _cqes[head & *_cq_mask];
+        std::atomic_ref<unsigned>{*_cq_head}.store(head + 1,
+                                                   std::memory_order_release);
+        return cqe;
+      }
+      auto rv = ::syscall(__NR_io_uring_enter, _fd, 0, 1,
+                          IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (rv < 0 && errno != EINTR)
+        throw std::system_error{errno, std::generic_category(),
+                                "io_uring_enter"};
+    }
+  }
+}; // Ring
+
+struct Slot {
+  std::uint64_t offset = 0;   // file offset of this block
+  std::size_t   want   = 0;   // bytes in this block
+  std::size_t   got    = 0;   // bytes read so far
+  bool          busy   = false;
+}; // Slot
+
+} // anonymous
+
+/* Checksum a regular file with `depth` fixed, registered buffers of BufLen
+   bytes kept in flight through io_uring.  Completions may arrive in any
+   order; blocks are handed to the kernel strictly in file order.  When
+   io_uring is unavailable, or the input is not a regular file, fall back to
+   CrcSumStream.  */
+
+CrcType CrcSumUring(const std::filesystem::path& fname,
+                    std::streamsize* length, unsigned depth)
+{
+  auto fallback = [&]() { return CrcSumFile(fname, length, SumOptions{}); };
+
+  auto file = FileDesc{::open(fname.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (file.fd < 0)
+    throw std::runtime_error{"cannot read"};
+
+  struct stat st;
+  if (::fstat(file.fd, &st) != 0)
+    throw std::system_error{errno, std::generic_category(), "fstat"};
+  if (!S_ISREG(st.st_mode) || st.st_size <= 0)
+    return fallback();
+  auto size = static_cast<std::uint64_t>(st.st_size);
+
+  depth = std::clamp(depth, 1u, 64u);
+  auto blocks = (size + BufLen - 1) / BufLen;
+  depth = static_cast<unsigned>(std::min<std::uint64_t>(depth, blocks));
+
+  // Declared before the ring, so that the ring always goes first.
+  auto mem = std::unique_ptr<std::byte, decltype(&std::free)>{
+      static_cast<std::byte*>(std::aligned_alloc(4096, depth * BufLen)),
+      &std::free};
+  if (!mem)
+    throw std::bad_alloc{};
+
+  auto ring = Ring{depth};
+  if (!ring)
+    return fallback();
+  auto iov = std::vector<iovec>(depth);
+  for (unsigned i = 0; i != depth; ++i)
+    iov[i] = iovec{mem.get() + i * BufLen, BufLen};
+  if (!ring.RegisterBuffers(iov.data(), depth))
+    return fallback();
+
+  auto slots = std::vector<Slot>(depth);
+  auto inflight = unsigned{0};
+
+  /* Closing the ring does not wait for its reads, so if Submit or Wait
+     throws, the reads the kernel took must still complete before the
+     buffers are freed.  Should even that fail, the buffers are leaked
+     rather than handed back to the heap while the kernel may write them.  */
+  struct Drain {
+    Ring& ring;
+    unsigned& inflight;
+    decltype(mem)& buffers;
+    ~Drain() {
+      try {
+        for ( ; inflight > ring.pending(); --inflight)
+          ring.Wait();
+      }
+      catch (...) {
+        static_cast<void>(buffers.release());
+      }
+    }
+  }; // Drain
+  auto drain = Drain{ring, inflight, mem};
+
+  auto issue = [&](unsigned i) {
+    auto& s = slots[i];
+    ring.ReadFixed(file.fd, mem.get() + i * BufLen + s.got,
+                   static_cast<unsigned>(s.want - s.got), s.offset + s.got,
+                   i, i);
+    s.busy = true;
+    ++inflight;
+  };
+
+  auto start = [&](unsigned i, std::uint64_t block) {
+    auto& s = slots[i];
+    s.offset = block * BufLen;
+    s.want   = static_cast<std::size_t>(std::min<std::uint64_t>(BufLen,
+                                                        size - s.offset));
+    s.got    = 0;
+    issue(i);
+  };
+
+  auto error = 0;
+  auto stop  = false;
+  auto reap  = [&]() {
+    auto cqe = ring.Wait();
+    auto i = static_cast<unsigned>(cqe.user_data);
+    auto& s = slots[i];
+    s.busy = false;
+    --inflight;
+    if (cqe.res < 0) {
+      if (!error) error = -cqe.res;
+      return;
+    }
+    s.got += static_cast<std::size_t>(cqe.res);
+    if (cqe.res != 0 && s.got < s.want && !stop && !error)
+      issue(i);
+  };
+
+  for (unsigned i = 0; i != depth; ++i)
+    start(i, i);
+
+  auto cksum_fp = CksumKernel();
+  auto crc = CrcType{0};
+  auto total_bytes = std::uint64_t{0};
+  for (std::uint64_t block = 0; block != blocks; ++block) {
+    auto i = static_cast<unsigned>(block % depth);
+    auto& s = slots[i];
+    for (;;) {
+      ring.Submit();
+      if (error || !s.busy)
+        break;
+      reap();
+    }
+    if (error)
+      break;
+    crc = cksum_fp(crc, mem.get() + i * BufLen, s.got);
+    total_bytes += s.got;
+    if (s.got != s.want)
+      break;
+    if (block + depth < blocks)
+      start(i, block + depth);
+  }
+
+  // The buffers must outlive every read the kernel still owns.
+  stop = true;
+  ring.Submit();
+  while (inflight != 0)
+    reap();
+
+  if (error)
+    throw std::system_error{error, std::generic_category(), "read"};
+
+  if (length)
+    *length = static_cast<std::streamsize>(total_bytes);
+
+  return CrcFinal(crc, total_bytes);
+} // CrcSumUring
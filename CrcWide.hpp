@@ -0,0 +1,101 @@
+#pragma once
+// Shared by cksum_vpclmul256.cpp and cksum_vpclmul512.cpp.  Include after
+// Simd.hpp; everything here has internal linkage, so each unit keeps the copy
+// built for its own TJG_SIMD_ISA.
+#include "cksum.hpp"
+#include "CrcConsts.hpp"
+#include "CrcBarrett.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace {
+
+using simd::uint128_t;
+using C = tjg::crc::Crc32Consts;
+
+#if TJG_SIMD_WIDE >= 256
+
+// Fold distances for a register V: one register (K1) and four registers (K4).
+template<typename V> struct WideK;
+
+template<> struct WideK<simd::uint64x4_t> {
+  using V = simd::uint64x4_t;
+  static V Load(const std::byte* p) noexcept { return simd::LoadBig256(p); }
+  static constexpr V K1 = V{C::K256_lo,  C::K256_hi,  C::K256_lo,  C::K256_hi};
+  static constexpr V K4 = V{C::K1024_lo, C::K1024_hi, C::K1024_lo, C::K1024_hi};
+}; // WideK<uint64x4_t>
+
+#if TJG_SIMD_WIDE >= 512
+template<> struct WideK<simd::uint64x8_t> {
+  using V = simd::uint64x8_t;
+  static V Load(const std::byte* p) noexcept { return simd::LoadBig512(p); }
+  static constexpr V K1 = V{C::K512_lo,  C::K512_hi,  C::K512_lo,  C::K512_hi,
+                            C::K512_lo,  C::K512_hi,  C::K512_lo,  C::K512_hi};
+  static constexpr V K4 = V{C::K2048_lo, C::K2048_hi, C::K2048_lo, C::K2048_hi,
+                            C::K2048_lo, C::K2048_hi, C::K2048_lo, C::K2048_hi};
+}; // WideK<uint64x8_t>
+#endif
+
+// Same folding scheme as do_cksum_simd, but each accumulator holds
+// sizeof(V)/16 consecutive 128-bit blocks.  num counts whole registers.
+template<typename V>
+uint128_t do_cksum_wide(uint128_t init, const std::byte* buf, std::size_t num)
+  noexcept
+{
+  using K = WideK<V>;
+  constexpr auto Step = sizeof(V);
+  const auto SingleK = simd::uint64x2_t{C::K128_lo, C::K128_hi};
+
+  auto first = V{};
+  first[0] = static_cast<std::uint64_t>(init);
+  first[1] = static_cast<std::uint64_t>(init >> 64);
+  auto data0 = K::Load(buf) ^ first;
+
+  if (num >= 8) {
+    auto data1 = K::Load(buf + 1*Step);
+    auto data2 = K::Load(buf + 2*Step);
+    auto data3 = K::Load(buf + 3*Step);
+
+    for ( ; num >= 8; num -= 4) {
+      buf += 4*Step;
+      data0 = simd::ClMulDiag(data0, K::K4) ^ K::Load(buf + 0*Step);
+      data1 = simd::ClMulDiag(data1, K::K4) ^ K::Load(buf + 1*Step);
+      data2 = simd::ClMulDiag(data2, K::K4) ^ K::Load(buf + 2*Step);
+      data3 = simd::ClMulDiag(data3, K::K4) ^ K::Load(buf + 3*Step);
+    }
+
+    data0 = simd::ClMulDiag(data0, K::K1) ^ data1;
+    data0 = simd::ClMulDiag(data0, K::K1) ^ data2;
+    data0 = simd::ClMulDiag(data0, K::K1) ^ data3;
+    num -= 3;
+    buf += 3*Step;
+  }
+  for ( ; num >= 2; --num) {
+    buf += Step;
+    data0 = simd::ClMulDiag(data0, K::K1) ^ K::Load(buf);
+  }
+
+  auto lanes = simd::Lanes(data0);
+  auto acc = lanes[0];
+  for (std::size_t i = 1; i != lanes.size(); ++i)
+    acc = simd::ClMulDiag(acc, SingleK) ^ lanes[i];
+  return std::bit_cast<uint128_t>(acc);
+} // do_cksum_wide
+
+template<typename V>
+CrcType cksum_wide(CrcType crc, const void* buf, std::size_t size) noexcept {
+  constexpr auto Step = sizeof(V);
+  if (size < 8 * Step)
+    return cksum_simd(crc, buf, size);
+  auto bp = reinterpret_cast<const std::byte*>(buf);
+  auto n  = size / Step;
+  auto u  = do_cksum_wide<V>(uint128_t{crc} << (128-32), bp, n);
+  crc = CrcType(tjg::crc::BarrettReduce<C>(u, simd::clmul));
+  return cksum_simd(crc, bp + n * Step, size % Step);
+} // cksum_wide
+
+#endif
+
+} // anonymous
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <unistd.h>
+
+/// Owns an open file descriptor; -1 means none.
+struct FileDesc {
+  int fd = -1;
+  explicit FileDesc(int fd_) noexcept : fd{fd_} { }
+  FileDesc(const FileDesc&) = delete;
+  FileDesc& operator=(const FileDesc&) = delete;
+  ~FileDesc() { if (fd >= 0) ::close(fd); }
+}; // FileDesc
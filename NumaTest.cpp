@@ -0,0 +1,95 @@
+#include "cksum.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/* A mock of the part of sysfs DeviceNode reads: two NVMe controllers on
+   PCI functions of nodes 1 and 0, one of node -1 as on a machine without
+   NUMA, and device-mapper devices over them.  */
+void MakeTree(const fs::path& root) {
+  const auto pci = root / "devices/pci0000:00";
+  const auto block = root / "class/block";
+  auto fn = [&](const char* name, const char* node) {
+    fs::create_directories(pci / name);
+    std::ofstream{pci / name / "numa_node"} << node << '\n';
+  };
+  auto dev = [&](const fs::path& dir) {
+    fs::create_directories(dir);
+    fs::create_directory_symlink(dir, block / dir.filename());
+  };
+  fs::create_directories(block);
+  fs::create_directories(root / "dev/block");
+  fn("0000:00:01.0", "1");
+  fn("0000:00:02.0", "0");
+  fn("0000:00:03.0", "-1");
+  dev(pci / "0000:00:01.0/nvme/nvme0/nvme0n1/nvme0n1p1");
+  dev(pci / "0000:00:01.0/nvme/nvme0/nvme0n2");
+  dev(pci / "0000:00:02.0/nvme/nvme1/nvme1n1");
+  dev(pci / "0000:00:03.0/nvme/nvme2/nvme2n1");
+  dev(root / "devices/virtual/block/dm-0");
+  dev(root / "devices/virtual/block/dm-1");
+  auto slave = [&](const char* dm, const char* member) {
+    auto slaves = block / dm / "slaves";
+    fs::create_directories(slaves);
+    fs::create_directory_symlink(block / member, slaves / member);
+  };
+  slave("dm-0", "nvme0n1p1");
+  slave("dm-0", "nvme0n2");
+  slave("dm-1", "nvme0n2");
+  slave("dm-1", "nvme1n1");
+} // MakeTree
+
+} // anonymous
+
+/* Each case gets a tree of its own, with this program's file system
+   standing in as the block device named by `device`, since DeviceNode
+   remembers the answer for each tree and device.  */
+
+int main() {
+  const auto base = fs::absolute("numa_sysfs");
+  fs::remove_all(base);
+  struct stat st;
+  if (::stat(".", &st) != 0) {
+    std::cerr << "NumaTest: cannot stat .\n";
+    return EXIT_FAILURE;
+  }
+  const auto dev = std::to_string(major(st.st_dev)) + ':'
+                 + std::to_string(minor(st.st_dev));
+
+  struct Case { const char* device; int node; };
+  const Case cases[] = {
+    {"nvme0n1p1",  1},    // partition: up through its disk to the PCI node
+    {"nvme1n1",    0},
+    {"nvme2n1",   -1},    // machine without NUMA
+    {"dm-0",       1},    // every member on node 1
+    {"dm-1",      -1},    // members on different nodes
+    {nullptr,     -1},    // not in sysfs at all
+  };
+  auto failed = 0;
+  auto n = 0;
+  for (const auto& c: cases) {
+    auto root = base / std::to_string(n++);
+    MakeTree(root);
+    if (c.device)
+      fs::create_directory_symlink(root / "class/block" / c.device,
+                                   root / "dev/block" / dev);
+    auto node = DeviceNode(".", root);
+    if (node != c.node) {
+      std::cerr << "NumaTest: " << (c.device ? c.device : "(none)")
+                << ": node " << node << ", expected " << c.node << '\n';
+      ++failed;
+    }
+  }
+  fs::remove_all(base);
+  return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+} // main
@@ -13,6 +13,32 @@
 #include <string>
 #include <utility>
 #include <bit>
+#include <iostream>
+#include <iomanip>
+
+// A kernel translation unit may define TJG_SIMD_ISA before including this
+// header to build everything after this point for that x86 ISA level,
+// independent of the global -march, so one binary can carry kernels for
+// several levels:
+//   1: AVX + PCLMULQDQ
+//   2: AVX2 + VPCLMULQDQ (256-bit)
+//   3: AVX-512BW/VL + VPCLMULQDQ (512-bit)
+// Include all other headers first, so inline code shared with other units is
+// not built for the wider ISA.  GCC does not update the feature macros for a
+// target pragma in C++, so the level also stands in for them below.
+#if !defined(TJG_SIMD_ISA) || !defined(__GNUC__) || defined(__clang__) \
+ || !(defined(__i386__) || defined(__x86_64__))
+  #undef  TJG_SIMD_ISA
+  #define TJG_SIMD_ISA 0
+#elif TJG_SIMD_ISA == 1
+  #pragma GCC target("avx,pclmul")
+#elif TJG_SIMD_ISA == 2
+  #pragma GCC target("avx2,pclmul,vpclmulqdq")
+#elif TJG_SIMD_ISA == 3
+  #pragma GCC target("avx512f,avx512bw,avx512vl,pclmul,vpclmulqdq")
+#else
+  #error "Unknown TJG_SIMD_ISA level."
+#endif
 
 #undef TJG_SIMD_BUILTIN
 #define TJG_SIMD_NEON  1
@@ -20,7 +46,7 @@
 
 // x86 PCLMUL
 #if (defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64))
-  #if defined(__PCLMUL__) || defined(__PCLMULQDQ__)
+  #if defined(__PCLMUL__) || defined(__PCLMULQDQ__) || TJG_SIMD_ISA >= 1
     #define TJG_SIMD_BUILTIN TJG_SIMD_SSE
     #include <immintrin.h>
   #endif
@@ -38,8 +64,24 @@
 #error "No SIMD support detected."
 #endif
 
-#include <iostream>
-#include <iomanip>
+// x86 VPCLMULQDQ on 256-bit (AVX2) and 512-bit (AVX512BW) registers.
+#define TJG_SIMD_WIDE 0
+#if TJG_SIMD_ISA >= 3
+  #undef  TJG_SIMD_WIDE
+  #define TJG_SIMD_WIDE 512
+#elif TJG_SIMD_ISA == 2
+  #undef  TJG_SIMD_WIDE
+  #define TJG_SIMD_WIDE 256
+#elif TJG_SIMD_ISA == 0 && TJG_SIMD_BUILTIN == TJG_SIMD_SSE \
+   && defined(__VPCLMULQDQ__)
+  #if defined(__AVX512F__) && defined(__AVX512BW__)
+    #undef  TJG_SIMD_WIDE
+    #define TJG_SIMD_WIDE 512
+  #elif defined(__AVX2__)
+    #undef  TJG_SIMD_WIDE
+    #define TJG_SIMD_WIDE 256
+  #endif
+#endif
 
 namespace simd {
 
@@ -59,6 +101,17 @@ using uint32x4_t = VectorT<std::uint32_t>;
 using uint64x2_t = VectorT<std::uint64_t>;
 #endif
 
+#if TJG_SIMD_WIDE >= 256
+template<std::unsigned_integral T>
+using Vector256T [[gnu::vector_size(32)]] = T;
+using uint64x4_t = Vector256T<std::uint64_t>;
+#endif
+#if TJG_SIMD_WIDE >= 512
+template<std::unsigned_integral T>
+using Vector512T [[gnu::vector_size(64)]] = T;
+using uint64x8_t = Vector512T<std::uint64_t>;
+#endif
+
 using VectorTypes = boost::mp11::mp_list<
                                 uint8x16_t, uint16x8_t, uint32x4_t, uint64x2_t>;
 
@@ -118,6 +171,7 @@ constexpr V FullSwap(V v) noexcept {
   return (V) Reverse((uint8x16_t) v);
 } // FullSwap
 
+[[gnu::always_inline]]
 constexpr uint128_t clmul(std::uint64_t x, std::uint64_t y) noexcept {
 #if TJG_SIMD_BUILTIN == TJG_SIMD_NEON
   return __builtin_neon_vmull_p64(x, y);
@@ -130,6 +184,7 @@ constexpr uint128_t clmul(std::uint64_t x, std::uint64_t y) noexcept {
 #endif
 } // clmul
 
+[[gnu::always_inline]]
 constexpr uint64x2_t ClMulDiag(uint64x2_t x, uint64x2_t y)
   noexcept
 {
@@ -451,10 +506,63 @@ public:
     { return r >>= rhs; return *this; }
 }; // Simd
 
+[[gnu::always_inline]]
 constexpr Simd<uint64x2_t> ClMulDiag(Simd<uint64x2_t> x, Simd<uint64x2_t> y)
   noexcept
   { return Simd<uint64x2_t>{ClMulDiag(x.r, y.r)}; }
 
+// Wide registers are treated as arrays of independent 128-bit lanes; every
+// operation below acts on each lane exactly as its uint64x2_t counterpart.
+// These are always inlined so no out-of-line copy built for one ISA is shared
+// with a unit built for another.
+#if TJG_SIMD_WIDE >= 256
+[[gnu::always_inline]]
+inline uint64x4_t ClMulDiag(uint64x4_t x, uint64x4_t y) noexcept {
+  auto t1 = _mm256_clmulepi64_epi128((__m256i) x, (__m256i) y, 0x00);
+  auto t2 = _mm256_clmulepi64_epi128((__m256i) x, (__m256i) y, 0x11);
+  return (uint64x4_t) (t1 ^ t2);
+} // ClMulDiag
+
+/// Load 32 bytes, each 128-bit lane big-endian.
+[[gnu::always_inline]]
+inline uint64x4_t LoadBig256(const void* p) noexcept {
+  const auto Rev = _mm256_set_epi8(
+          0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+          0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  auto v = _mm256_loadu_si256(static_cast<const __m256i*>(p));
+  return (uint64x4_t) _mm256_shuffle_epi8(v, Rev);
+} // LoadBig256
+
+[[gnu::always_inline]]
+inline std::array<uint64x2_t, 2> Lanes(uint64x4_t v) noexcept
+  { return std::bit_cast<std::array<uint64x2_t, 2>>(v); }
+#endif
+
+#if TJG_SIMD_WIDE >= 512
+[[gnu::always_inline]]
+inline uint64x8_t ClMulDiag(uint64x8_t x, uint64x8_t y) noexcept {
+  auto t1 = _mm512_clmulepi64_epi128((__m512i) x, (__m512i) y, 0x00);
+  auto t2 = _mm512_clmulepi64_epi128((__m512i) x, (__m512i) y, 0x11);
+  return (uint64x8_t) _mm512_xor_si512(t1, t2);
+} // ClMulDiag
+
+/// Load 64 bytes, each 128-bit lane big-endian.
+[[gnu::always_inline]]
+inline uint64x8_t LoadBig512(const void* p) noexcept {
+  const auto Rev = _mm512_set_epi64(
+          0x0001020304050607, 0x08090a0b0c0d0e0f,
+          0x0001020304050607, 0x08090a0b0c0d0e0f,
+          0x0001020304050607, 0x08090a0b0c0d0e0f,
+          0x0001020304050607, 0x08090a0b0c0d0e0f);
+  auto v = _mm512_loadu_si512(p);
+  return (uint64x8_t) _mm512_shuffle_epi8(v, Rev);
+} // LoadBig512
+
+[[gnu::always_inline]]
+inline std::array<uint64x2_t, 4> Lanes(uint64x8_t v) noexcept
+  { return std::bit_cast<std::array<uint64x2_t, 4>>(v); }
+#endif
+
 template<std::integral T>
 struct P: std::conditional<(sizeof(T) > 1), T, unsigned> { };
 template<std::integral T> using P_t = P<T>::type;
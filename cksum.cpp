@@ -1,88 +1,410 @@
 #include "CrcUpdate.hpp"
+#include "CrcEngine.hpp"
 #include "cksum.hpp"
+#include "FileDesc.hpp"
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
+#include <system_error>
+#include <string_view>
+#include <atomic>
+#include <array>
+#include <span>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cerrno>
 
-#if USE_VMULL_CRC32
-#include <sys/auxv.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+CrcType cksum_update(CrcType crc, const void* buf, std::size_t size) noexcept {
+  return CrcUpdate(crc, buf, size);
+}
+
+#if USE_PCLMUL_CRC32
+static bool HasPclmul() noexcept { return tjg::crc::FoldSupported(); }
+
+static bool HasVpclmul256() noexcept {
+  return (HasPclmul()
+       && __builtin_cpu_supports("vpclmulqdq") > 0
+       && __builtin_cpu_supports("avx2")       > 0);
+}
+
+static bool HasVpclmul512() noexcept {
+  return (HasVpclmul256()
+       && __builtin_cpu_supports("avx512f")  > 0
+       && __builtin_cpu_supports("avx512bw") > 0
+       && __builtin_cpu_supports("avx512vl") > 0);
+}
 #endif
 
-/* Number of bytes to read at once.  */
-constexpr std::size_t BufLen = 1 << 16;
+#if USE_VMULL_CRC32
+static bool HasPmull() noexcept { return tjg::crc::FoldSupported(); }
+#endif
 
-using cksum_fp_t = CrcType (*)(CrcType crc, const void* buf, std::size_t size);
+static bool Always() noexcept { return true; }
 
-static cksum_fp_t pclmul_supported(void) {
+/* Every kernel built into this binary, best first.  Each kernel unit is
+   compiled for its own ISA level, so only the CPU check decides.  */
+static const KernelInfo Kernels[] = {
 #if USE_PCLMUL_CRC32
-  bool pclmul_enabled = (__builtin_cpu_supports("pclmul") > 0
-                      && __builtin_cpu_supports("avx")    > 0);
-  if (CksumDebug) {
-    if (pclmul_enabled)
-      std::cerr << "using pclmul hardware support\n";
-    else
-      std::cerr << "pclmul support not detected\n";
-  }
-  if (pclmul_enabled)
-    return cksum_simd;
+  { "vpclmul512", cksum_vpclmul512, HasVpclmul512 },
+  { "vpclmul256", cksum_vpclmul256, HasVpclmul256 },
+  { "simd",       cksum_simd,       HasPclmul     },
+  { "pclmul0",    cksum_pclmul0,    HasPclmul     },
+  { "simd2",      cksum_simd2,      HasPclmul     },
+  { "simd8",      cksum_simd8,      HasPclmul     },
+  { "simd16",     cksum_simd16,     HasPclmul     },
 #endif
-  return nullptr;
-} // pclmul_supported
-
-static cksum_fp_t vmull_supported(void) {
-  /* vmull for multiplication  */
 #if USE_VMULL_CRC32
-  bool vmull_enabled = (getauxval(AT_HWCAP) & HWCAP_PMULL) > 0;
-  if (CksumDebug) {
-    if (vmull_enabled)
-      std::cerr << "using vmull hardware support\n";
-    else
-      std::cerr << "vmull support not detected\n";
-  }
-  if (vmull_enabled)
-    return cksum_simd;
+  { "simd",       cksum_simd,       HasPmull      },
+  { "vmull0",     cksum_vmull0,     HasPmull      },
+  { "simd2",      cksum_simd2,      HasPmull      },
+  { "simd8",      cksum_simd8,      HasPmull      },
+  { "simd16",     cksum_simd16,     HasPmull      },
 #endif
+  { "slice32",    cksum_slice32,    Always        },
+  { "multi",      cksum_multi,      Always        },
+  { "slice16",    cksum_slice16,    Always        },
+  { "slice8",     cksum_slice8,     Always        },
+};
+
+static const KernelInfo* FindKernel(std::string_view name) noexcept {
+  for (const auto& k: Kernels) {
+    if (name == k.name)
+      return k.supported() ? &k : nullptr;
+  }
   return nullptr;
-} // vmull_supported
+} // FindKernel
 
-CrcType cksum_update(CrcType crc, const void* buf, std::size_t size) noexcept {
-  return CrcUpdate(crc, buf, size);
+// Resolved once, on first use, by the thread-safe static initialization.
+static const KernelInfo& BestKernel() {
+  static const KernelInfo& best = []() -> const KernelInfo& {
+    const KernelInfo* k = nullptr;
+    if (auto env = std::getenv("CKSUM_KERNEL")) {
+      k = FindKernel(env);
+      if (!k)
+        std::cerr << "CKSUM_KERNEL=" << env << ": unknown or unsupported\n";
+    }
+    for (const auto& cand: Kernels) {
+      if (k) break;
+      if (cand.supported()) k = &cand;
+    }
+    if (CksumDebug)
+      std::cerr << "using " << k->name << " kernel\n";
+    return *k;
+  }();
+  return best;
+} // BestKernel
+
+static std::atomic<const KernelInfo*> Override{nullptr};
+
+std::span<const KernelInfo> CksumKernels() noexcept { return Kernels; }
+
+const KernelInfo& CksumKernelInfo() {
+  if (auto k = Override.load(std::memory_order_acquire))
+    return *k;
+  return BestKernel();
+} // CksumKernelInfo
+
+/* The kernel a timing wrapper forwards to, and the wrapper's running total
+   for each thread.  A call of 64 KiB or more takes microseconds, so the two
+   clock reads around it are lost in the noise.  */
+static std::atomic<cksum_fp_t> Timed{nullptr};
+static thread_local std::chrono::steady_clock::duration KernelTime{};
+
+static CrcType TimedKernel(CrcType crc, const void* buf, std::size_t size)
+  noexcept
+{
+  using Clock = std::chrono::steady_clock;
+  auto t0 = Clock::now();
+  crc = Timed.load(std::memory_order_relaxed)(crc, buf, size);
+  KernelTime += Clock::now() - t0;
+  return crc;
+} // TimedKernel
+
+cksum_fp_t CksumKernel() {
+  if (Timed.load(std::memory_order_acquire))
+    return TimedKernel;
+  return CksumKernelInfo().fn;
+} // CksumKernel
+
+void CksumTimeKernel() {
+  Timed.store(CksumKernelInfo().fn, std::memory_order_release);
 }
 
-/* Calculate the checksum and length in bytes of stream STREAM.
-   Return false on error, true on success.  */
+double CksumKernelTime() noexcept
+  { return std::chrono::duration<double>{KernelTime}.count(); }
 
-CrcType CrcSumStream(std::ifstream& stream, std::streamsize* length) {
-  static cksum_fp_t cksum_fp;
-  if (!cksum_fp)
-    cksum_fp = pclmul_supported();
-  if (!cksum_fp)
-    cksum_fp = vmull_supported();
-  if (!cksum_fp)
-    cksum_fp = cksum_slice8;
+bool CksumSelect(std::string_view name) noexcept {
+  auto k = FindKernel(name);
+  if (!k)
+    return false;
+  Override.store(k, std::memory_order_release);
+  if (Timed.load(std::memory_order_acquire))
+    Timed.store(k->fn, std::memory_order_release);
+  return true;
+} // CksumSelect
 
-  auto crc = CrcType{0};
-  auto total_bytes = std::streamsize{0};
+CrcType CrcFinal(CrcType crc, std::uintmax_t length) noexcept {
+  for ( ; length; length >>= 8)
+    crc = CrcUpdate(crc, std::byte(length));
+  return ~crc;
+} // CrcFinal
+
+/* A byte update shifts the register left and xors in CrcTab[0][i], i being
+   the old top byte xor the data.  The generator has an x^0 term, so the low
+   bytes of the table entries are all different and give i back; from i the
+   old register follows.  */
+static constexpr auto UnTab = []() {
+  auto inv = std::array<std::uint8_t, 256>{};
+  for (unsigned i = 0; i != inv.size(); ++i)
+    inv[CrcTab[0][i] & 0xff] = static_cast<std::uint8_t>(i);
+  return inv;
+}();
+
+static CrcType CrcUndo(CrcType crc, std::byte b) noexcept {
+  auto i = CrcType{UnTab[crc & 0xff]};
+  auto top = i ^ std::to_integer<CrcType>(b);
+  return ((crc ^ CrcTab[0][i]) >> 8) | (top << 24);
+}
+
+CrcType CrcUnfinal(CrcType sum, std::uintmax_t length) noexcept {
+  auto crc = ~sum;
+  auto bytes = 0;
+  for (auto n = length; n; n >>= 8)
+    ++bytes;
+  while (bytes--)
+    crc = CrcUndo(crc, std::byte(length >> 8*bytes));
+  return crc;
+} // CrcUnfinal
+
+/* Whole buffers, so each takes the length suffix.  Without carry-less
+   multiply there is no batch kernel and the buffers go one at a time.  */
+void CrcSumBatch(std::span<const CrcBuffer> bufs, std::span<CrcType> sums) {
+  if (sums.size() < bufs.size())
+    throw std::invalid_argument{"CrcSumBatch: too few sums"};
+  sums = sums.first(bufs.size());
+  std::ranges::fill(sums, CrcType{0});
+  if (tjg::crc::FoldSupported()) {
+    cksum_batch(bufs, sums);
+  }
+  else {
+    auto cksum_fp = CksumKernel();
+    for (std::size_t i = 0; i != bufs.size(); ++i)
+      sums[i] = cksum_fp(sums[i], bufs[i].data(), bufs[i].size());
+  }
+  for (std::size_t i = 0; i != bufs.size(); ++i)
+    sums[i] = CrcFinal(sums[i], bufs[i].size());
+} // CrcSumBatch
+
+std::uintmax_t CrcAccumulator::update_fd(int fd) {
   using uint128_t = unsigned __int128;
   alignas(uint128_t) auto buf = std::array<std::byte, BufLen>{};
-  auto cbuf = reinterpret_cast<char*>(buf.data());
+  auto total = std::uintmax_t{0};
+  for (;;) {
+    auto n = ::read(fd, buf.data(), buf.size());
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      throw std::system_error{errno, std::generic_category(), "read"};
+    }
+    if (n == 0)
+      break;
+    update(std::span{buf.data(), static_cast<std::size_t>(n)});
+    total += static_cast<std::uintmax_t>(n);
+  }
+  return total;
+} // update_fd
+
+namespace {
+
+/* Read sizes for one pass over a stream.  A stream known to fit in one
+   BufLen read gets a buffer just its size, rounded up to a page.  Longer
+   ones start at BufLen and double, up to MaxReadLen, while each doubling
+   raises the measured rate by at least an eighth; the first doubling that
+   does not is undone and the size then stays put.  The rate covers reading
+   and summing, over at least four reads and a MiB at each size, so a fast
+   device earns big reads while a file already in the page cache keeps a
+   buffer small enough to stay in the CPU cache.  The first read at each
+   size lands in freshly faulted memory and is not counted.  */
+class ReadSizer {
+public:
+  explicit ReadSizer(std::uintmax_t hint) noexcept {
+    constexpr std::uintmax_t Page = 4096;
+    if (hint != 0 && hint < BufLen)
+      _len = static_cast<std::size_t>((hint + Page - 1) / Page * Page);
+  }
+
+  std::size_t size() const noexcept { return _len; }
+
+  /// Account for reading and summing size() bytes in `ns` nanoseconds.
+  void filled(std::int64_t ns) noexcept {
+    constexpr std::uintmax_t MinSample = 16 * BufLen;
+    if (_settled)
+      return;
+    if (_fresh) {
+      _fresh = false;
+      return;
+    }
+    _bytes += _len;
+    _ns    += ns;
+    if (_bytes < std::max<std::uintmax_t>(4 * _len, MinSample))
+      return;
+    auto rate = double(_bytes) / double(std::max<std::int64_t>(_ns, 1));
+    _bytes = 0;
+    _ns    = 0;
+    if (_rate != 0 && rate < _rate * 1.125) {
+      _len /= 2;
+      _settled = true;
+    }
+    else if (_len >= MaxReadLen) {
+      _settled = true;
+    }
+    else {
+      _rate = rate;
+      _len *= 2;
+      _fresh = true;
+    }
+  }
+
+private:
+  std::size_t _len = BufLen;
+  double _rate = 0;         // bytes per ns at _len / 2
+  std::uintmax_t _bytes = 0;  // sampled so far at _len
+  std::int64_t _ns = 0;
+  bool _fresh = true;       // next read is the first at _len
+  bool _settled = false;
+}; // ReadSizer
+
+/* Keep the kernel loading at least a window beyond the current read, on
+   top of its own read-ahead, which is sized for disks rather than NVMe.
+   The hints are per file, so any descriptor of it will do.  Hints go out
+   two windows at a time: hinting just a read or two ahead only put the
+   hint's own page-cache work on the summing thread, measurably slowing a
+   cold pass.  */
+class ReadAhead {
+public:
+  explicit ReadAhead(int fd) noexcept : _fd{fd} { }
+
+  void before(std::uintmax_t offset, std::size_t len) noexcept {
+    constexpr std::uintmax_t Window = 2 * MaxReadLen;
+    auto need = offset + len + Window;
+    if (_fd < 0 || need <= _ahead)
+      return;
+    _ahead = std::max(_ahead, offset);
+    auto end = need + Window;
+    ::posix_fadvise(_fd, static_cast<off_t>(_ahead),
+                    static_cast<off_t>(end - _ahead), POSIX_FADV_WILLNEED);
+    _ahead = end;
+  }
+
+private:
+  int _fd;
+  std::uintmax_t _ahead = 0;   // hinted up to here
+}; // ReadAhead
+
+} // anonymous
+
+/* Block CRCs come out of the same pass: reads are split at block boundaries,
+   and a block's CRC is the running CRC at its end xor the one at its start
+   advanced over the block, one multiplication per block.  */
+
+CrcType CrcSumStream(std::ifstream& stream, std::streamsize* length,
+                     BlockCrcs* blocks, int advise)
+{
+  using C = tjg::crc::Crc32Consts;
+  using Clock = std::chrono::steady_clock;
+  auto acc = CrcAccumulator{};
+  if (blocks && blocks->size == 0)
+    blocks = nullptr;
+  const auto advance = blocks ? C::XpowMod(8 * blocks->size) : 1;
+  auto start = CrcType{0};    // running CRC where the current block began
+  auto fill  = std::uintmax_t{0};
+  auto total_bytes = std::streamsize{0};
 
   stream.exceptions(std::ios::badbit);
+  auto origin = std::uintmax_t{0};
+  auto hint   = std::uintmax_t{0};
+  if (auto here = stream.tellg(); here >= 0) {
+    origin = static_cast<std::uintmax_t>(here);
+    stream.seekg(0, std::ios::end);
+    if (auto end = stream.tellg(); end > here)
+      hint = static_cast<std::uintmax_t>(end - here);
+    stream.seekg(here);
+  }
+  stream.clear();
+  auto sizer = ReadSizer{hint};
+  auto ahead = ReadAhead{(hint > sizer.size()) ? advise : -1};
+
+  // Grown by doubling only, so the last buffer is the only large one.
+  using uint128_t = unsigned __int128;
+  auto mem = std::unique_ptr<uint128_t[]>{};
+  auto cap = std::size_t{0};
+
+  auto last = Clock::now();
+  auto last_full = false;     // whether the previous read filled its buffer
   do {
-    stream.read(cbuf, BufLen);
+    auto now = Clock::now();
+    if (last_full) {
+      sizer.filled(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     now - last).count());
+    }
+    last = now;
+    auto want = sizer.size();
+    if (want > cap) {
+      auto n = want / sizeof(uint128_t);
+      mem = std::make_unique_for_overwrite<uint128_t[]>(n);
+      cap = want;
+    }
+    auto buf  = reinterpret_cast<std::byte*>(mem.get());
+    auto cbuf = reinterpret_cast<char*>(buf);
+    ahead.before(origin + static_cast<std::uintmax_t>(total_bytes), want);
+    stream.read(cbuf, static_cast<std::streamsize>(want));
     auto bytes_read = stream.gcount();
     if (bytes_read == 0)
       break;
+    last_full = (static_cast<std::size_t>(bytes_read) == want);
     if (total_bytes + bytes_read < total_bytes)
       throw std::overflow_error{"Failure reading input stream"};
     total_bytes += bytes_read;
-    auto len = static_cast<std::size_t>(bytes_read);
-    crc = cksum_fp(crc, buf.data(), len);
+    auto data = std::span{buf, static_cast<std::size_t>(bytes_read)};
+    while (blocks && !data.empty()) {
+      auto take = static_cast<std::size_t>(
+                    std::min<std::uintmax_t>(data.size(), blocks->size - fill));
+      acc.update(data.first(take));
+      data = data.subspan(take);
+      fill += take;
+      if (fill == blocks->size) {
+        blocks->crcs.push_back(acc.raw() ^ CrcType(C::MulMod(start, advance)));
+        start = acc.raw();
+        fill  = 0;
+      }
+    }
+    acc.update(data);
   } while (!stream.eof());
+  if (blocks && fill != 0)
+    blocks->crcs.push_back(acc.raw() ^ CrcType(C::Shift(start, fill)));
 
   if (length)
     *length = total_bytes;
 
-  for ( ; total_bytes; total_bytes >>= 8)
-    crc = CrcUpdate(crc, std::byte(total_bytes));
-  return ~crc;
+  return acc.finalize();
 } // CrcSumStream
+
+/* The hints need a descriptor, which an ifstream does not expose, so the
+   file is opened a second time for them.  */
+
+CrcType CrcSumPath(const std::filesystem::path& fname,
+                   std::streamsize* length, BlockCrcs* blocks)
+{
+  auto fp = std::ifstream{fname, std::ios::in | std::ios::binary};
+  if (!fp)
+    throw std::runtime_error{"cannot read"};
+  auto advise = FileDesc{::open(fname.c_str(), O_RDONLY | O_CLOEXEC)};
+  return CrcSumStream(fp, length, blocks, advise.fd);
+} // CrcSumPath
@@ -1,13 +1,253 @@
 #pragma once
 #include "CrcUpdate.hpp"
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include <span>
+#include <string_view>
 #include <cstdint>
 
 constexpr bool CksumDebug = true;
 
-CrcType CrcSumStream(std::ifstream& stream, std::streamsize* length = nullptr);
+/* Number of bytes to read at once.  */
+constexpr std::size_t BufLen = 1 << 16;
+
+/* Largest read CrcSumStream grows to on a fast device.  */
+constexpr std::size_t MaxReadLen = 64 * BufLen;
+
+using cksum_fp_t = CrcType (*)(CrcType crc, const void* buf, std::size_t size);
+
+/// Input backends for CrcSumFile.
+enum class Reader {
+  Stream,   ///< std::ifstream, adaptively sized reads (CrcSumStream).
+  Mmap,     ///< Map the file and sum the pages in place (CrcSumMapped).
+  Uring,    ///< Several reads in flight through io_uring (CrcSumUring).
+  Direct,   ///< O_DIRECT into pooled 2 MiB huge pages (CrcSumDirect).
+};
+
+/// CRCs of the consecutive `size`-byte blocks of a stream, the last one
+/// possibly short.  Each is the raw CRC from 0 of its block alone, so a block
+/// can be checked again by summing just its range.
+struct BlockCrcs {
+  std::uintmax_t size = 0;
+  std::vector<CrcType> crcs;
+};
+
+/* Where the time went while one file was summed, in seconds on the thread
+   that summed it: wall == blocked + user + system.  Blocked is time off the
+   CPU, waiting for reads or page faults to complete; system is time in the
+   operating system on the CPU, copying from the page cache or mapping
+   pages.  Crc is the wall time inside checksum kernel calls, mostly user
+   time, though for a mapped file it takes in the page faults too.  With
+   SumOptions::threads the range threads' work counts as blocked.  */
+struct SumStats {
+  double wall    = 0;
+  double blocked = 0;
+  double user    = 0;
+  double system  = 0;
+  double crc     = 0;
+};
+
+/// Outcome of checksumming one file; `error` is empty on success.
+struct SumResult {
+  CrcType crc = CrcType{0};
+  std::streamsize length = 0;
+  std::string error;
+  BlockCrcs blocks;       ///< Filled when SumOptions::block is set.
+  SumStats stats;         ///< Filled when SumOptions::stats is set.
+};
+
+/// Earlier results by file name, as cksum printed them.
+using SumTable = std::map<std::string, SumResult, std::less<>>;
+
+/// Use of the checksum cached in each file's user.cksum attribute.
+enum class Cache {
+  Off,
+  Use,      ///< Trust an entry the file still matches; store one after a read.
+  Refresh,  ///< Read every file and store its entry afresh.
+};
+
+/// How CrcSumFile reads and checksums one file.
+struct SumOptions {
+  unsigned threads = 1;   ///< Concurrent ranges per file; 1 reads serially.
+  Reader   reader  = Reader::Stream;
+  bool populate = false;  ///< Prefault the whole mapping (MAP_POPULATE).
+  unsigned depth = 8;     ///< io_uring reads kept in flight.
+  Cache cache = Cache::Off;
+  unsigned verify = 0;    ///< Re-read about one cache hit in this many.
+  const SumTable* prior = nullptr;  ///< Files to extend (CrcSumAppended).
+  std::uintmax_t block = 0;  ///< Also list CRCs of blocks of this many bytes.
+  unsigned budget = 0;    ///< Reads in flight over all files; 0 is no limit.
+  bool stats = false;     ///< Fill SumResult::stats; needs CksumTimeKernel().
+  bool numa  = false;     ///< Pin to the file's NUMA node (NumaPlace).
+};
+
+/// One line of a --check list: what cksum printed for a file.
+struct CheckEntry {
+  std::filesystem::path name;
+  CrcType crc = CrcType{0};
+  std::streamsize length = 0;
+};
+
+using SumReport = std::function<void(std::size_t index, const SumResult&)>;
+
+/// A checksum kernel built into this binary.
+struct KernelInfo {
+  const char* name;
+  cksum_fp_t  fn;
+  bool (*supported)() noexcept;   ///< Whether this CPU can run it.
+};
+
+/// All kernels built into this binary, best first.
+std::span<const KernelInfo> CksumKernels() noexcept;
+
+/// The kernel in use: the best one this CPU supports, resolved once, unless
+/// CKSUM_KERNEL or CksumSelect() names another.
+const KernelInfo& CksumKernelInfo();
+cksum_fp_t CksumKernel();
+
+/// Pin the kernel by name.  Fails if unknown or unsupported by this CPU.
+bool CksumSelect(std::string_view name) noexcept;
+
+/// From now on CksumKernel() returns a wrapper that times each call of the
+/// kernel in use, at the cost of two clock reads per call.
+void CksumTimeKernel();
+
+/// Seconds the calling thread has spent in timed kernel calls.
+double CksumKernelTime() noexcept;
+
+/// Append the length suffix to a raw CRC and complement it.
+CrcType CrcFinal(CrcType crc, std::uintmax_t length) noexcept;
+
+/// Undo CrcFinal: the raw CRC of a stream from its cksum value and length.
+CrcType CrcUnfinal(CrcType sum, std::uintmax_t length) noexcept;
+
+/* Incremental cksum of one stream, for callers that hold data in memory or
+   behind a descriptor rather than in a file stream.  All state lives in the
+   object, so any number of accumulators may run on different threads; like a
+   standard container, one object must not be shared without locking.  The
+   kernel is resolved when the object is made.  */
+class CrcAccumulator {
+public:
+  CrcAccumulator() : _kernel{CksumKernel()} { }
+  explicit CrcAccumulator(cksum_fp_t kernel) noexcept : _kernel{kernel} { }
+
+  void update(std::span<const std::byte> data) noexcept {
+    _crc = _kernel(_crc, data.data(), data.size());
+    _length += data.size();
+  }
+
+  /// Read fd to end-of-file and return the number of bytes read.
+  std::uintmax_t update_fd(int fd);
+
+  /// The cksum value so far, length suffix included; updates may continue.
+  CrcType finalize() const noexcept { return CrcFinal(_crc, _length); }
+
+  CrcType raw() const noexcept { return _crc; }
+  std::uintmax_t length() const noexcept { return _length; }
+  void reset() noexcept { _crc = CrcType{0}; _length = 0; }
+
+  /// Continue a stream known only by its cksum value and length.
+  void resume(CrcType sum, std::uintmax_t length) noexcept
+    { _crc = CrcUnfinal(sum, length); _length = length; }
+
+private:
+  cksum_fp_t _kernel;
+  CrcType _crc = CrcType{0};
+  std::uintmax_t _length = 0;
+}; // CrcAccumulator
+
+/// Checksum the rest of a stream.  If `advise` is a descriptor of the same
+/// file, read-ahead hints for the stream are issued on it.
+CrcType CrcSumStream(std::ifstream& stream, std::streamsize* length = nullptr,
+                     BlockCrcs* blocks = nullptr, int advise = -1);
+
+/// CrcSumStream of a named file, with read-ahead hints.
+CrcType CrcSumPath(const std::filesystem::path& fname,
+                   std::streamsize* length = nullptr,
+                   BlockCrcs* blocks = nullptr);
+
+/// Append one file's block CRCs to a manifest, as text or binary.
+void WriteManifest(std::ostream& out, const std::string& name,
+                   const SumResult& result, bool binary);
+
+/// Sum ranges of a regular file on opts.threads threads and combine them.
+/// The ranges are read as streams; opts.reader is not used.
+CrcType CrcSumParallel(const std::filesystem::path& fname,
+                       std::streamsize* length, const SumOptions& opts);
+
+CrcType CrcSumMapped(const std::filesystem::path& fname,
+                     std::streamsize* length, bool populate = false);
+
+CrcType CrcSumUring(const std::filesystem::path& fname,
+                    std::streamsize* length, unsigned depth = 8);
+
+CrcType CrcSumDirect(const std::filesystem::path& fname,
+                     std::streamsize* length);
+
+/// CrcSumFile through the attribute cache selected by opts.cache.
+CrcType CrcSumCached(const std::filesystem::path& fname,
+                     std::streamsize* length, const SumOptions& opts);
+
+CrcType CrcSumFile(const std::filesystem::path& fname,
+                   std::streamsize* length = nullptr,
+                   const SumOptions& opts = SumOptions{});
+
+/// NUMA node of the block device holding fname, as sysfs shows it; -1 if
+/// unknown.  `sysfs` is where sysfs is mounted, or a mock tree for testing.
+int DeviceNode(const std::filesystem::path& fname,
+               const std::filesystem::path& sysfs = "/sys");
+
+/// Pin the calling thread to CPUs near fname's device, or else to a node of
+/// its own, before summing fname.
+void NumaPlace(const std::filesystem::path& fname, const SumOptions& opts);
+
+/// Extend `prior`, the result for fname when it was shorter, by reading
+/// only the bytes appended since.  Fails if the file is now shorter.
+CrcType CrcSumAppended(const std::filesystem::path& fname,
+                       const SumResult& prior, std::streamsize* length);
+
+/// Report fname's checksum, extending `start` if given, and again each time
+/// the file grows, until it is removed or renamed.
+void CrcFollow(const std::filesystem::path& fname, const SumResult* start,
+               const std::function<void(const SumResult&)>& report);
+
+/// Checksum many files on `jobs` threads, reporting each by its index.
+void CrcSumFiles(std::span<const std::filesystem::path> files,
+                 const SumOptions& opts, unsigned jobs, bool ordered,
+                 const SumReport& report);
+
+/// Checksum the files of a --check list like CrcSumFiles.  A file whose size
+/// differs from its entry is reported with that size, unread.
+void CrcCheckFiles(std::span<const CheckEntry> entries,
+                   const SumOptions& opts, unsigned jobs, bool ordered,
+                   const SumReport& report);
 
 CrcType cksum_slice8 (CrcType crc, const void* buf, std::size_t size) noexcept;
+CrcType cksum_slice16(CrcType crc, const void* buf, std::size_t size) noexcept;
+CrcType cksum_slice32(CrcType crc, const void* buf, std::size_t size) noexcept;
+CrcType cksum_multi  (CrcType crc, const void* buf, std::size_t size) noexcept;
 CrcType cksum_simd   (CrcType crc, const void* buf, std::size_t size) noexcept;
+CrcType cksum_simd2  (CrcType crc, const void* buf, std::size_t size) noexcept;
+CrcType cksum_simd8  (CrcType crc, const void* buf, std::size_t size) noexcept;
+CrcType cksum_simd16 (CrcType crc, const void* buf, std::size_t size) noexcept;
 CrcType cksum_vmull0 (CrcType crc, const void* buf, std::size_t size) noexcept;
 CrcType cksum_pclmul0(CrcType crc, const void* buf, std::size_t size) noexcept;
+CrcType cksum_vpclmul256(CrcType crc, const void* buf, std::size_t size)
+  noexcept;
+CrcType cksum_vpclmul512(CrcType crc, const void* buf, std::size_t size)
+  noexcept;
+
+/// One buffer of a batch.
+using CrcBuffer = std::span<const std::byte>;
+
+/// Continue crcs[i] over bufs[i] for every i, several short buffers at a
+/// time; long ones go to CksumKernel().
+void cksum_batch(std::span<const CrcBuffer> bufs, std::span<CrcType> crcs);
+
+/// The cksum value of each of many independent buffers, length suffix
+/// included.  `sums` must hold at least bufs.size() values.
+void CrcSumBatch(std::span<const CrcBuffer> bufs, std::span<CrcType> sums);
@@ -1,10 +1,15 @@
 #include "CrcUpdate.hpp"
+#include "CrcBarrett.hpp"
 
 #include "cksum.hpp"
 
 #include <vector>
 #include <bit>
 
+// Built for AVX+PCLMUL regardless of -march; CksumKernels() checks the CPU.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC target("avx,pclmul")
+#endif
 #include <x86intrin.h>
 
 using uint128_t = unsigned __int128;
@@ -95,18 +100,30 @@ U128 do_cksum_pclmul0(std::uint32_t crc, const U128* buf, size_t num) noexcept {
     data0 ^= temp0;
   }
 
-  data0 = _mm_shuffle_epi8(data0, ShuffleK);
   return (U128) data0;
 } // do_cksum_pclmul0
 
 CrcType cksum_pclmul0(CrcType crc, const void* buf, std::size_t size) noexcept {
+  // The kernel uses aligned loads; now that it can be selected at run time it
+  // may see any buffer, so byte-step to the first aligned block.
+  auto head = reinterpret_cast<std::uintptr_t>(buf) % alignof(U128);
+  if (head != 0 && size >= 2 * sizeof(U128)) [[unlikely]] {
+    head  = alignof(U128) - head;
+    crc   = CrcUpdate(crc, buf, head);
+    buf   = static_cast<const std::byte*>(buf) + head;
+    size -= head;
+  }
   auto n = size / sizeof(U128);
   auto r = size % sizeof(U128);
   if (n < 2)
     return CrcUpdate(crc, buf, size);
   auto p = reinterpret_cast<const U128*>(buf);
   auto u = do_cksum_pclmul0(crc, p, n);
-  crc = CrcUpdate(CrcType{0}, &u, sizeof(u));
+  auto clmul = [](std::uint64_t x, std::uint64_t y) -> U128 {
+    return (U128) _mm_clmulepi64_si128(_mm_cvtsi64_si128(x),
+                                       _mm_cvtsi64_si128(y), 0x00);
+  };
+  crc = CrcType(tjg::crc::BarrettReduce<tjg::crc::Crc32Consts>(u, clmul));
   crc = CrcUpdate(crc, p+n,r);
   return crc;
 } // cksum_pclmul0
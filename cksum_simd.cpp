@@ -1,76 +1,213 @@
 #include "cksum.hpp"
 #include "CrcConsts.hpp"
+#include "CrcBarrett.hpp"
+#include "CrcShort.hpp"
 
 #include "CrcUpdate.hpp"
-#include "Simd.hpp"
-
 #include "Int.hpp"
 
+#include <array>
+#include <utility>
 #include <bit>
+#include <cstring>
+#include <span>
+#include <algorithm>
+
+#define TJG_SIMD_ISA 1
+#include "Simd.hpp"
+#include "CrcFold.hpp"
 
 using simd::uint128_t;
 
 using U128 = tjg::Int<uint128_t, std::endian::big>;
 static_assert(alignof(U128) == alignof(uint128_t));
 
-uint128_t do_cksum_simd(uint128_t init, const U128* buf, std::size_t num)
-  noexcept
-{
+/* Number of independent 128-bit accumulators in the main loop of cksum_simd;
+   each folds forward over FoldWidth blocks per iteration.  Override at build
+   time to match the clmul latency/throughput of the target.  The loop is the
+   generic engine's FoldBlocks; only the short first block and the vector
+   reduction around it are cksum's own.  */
+#ifndef CKSUM_FOLD_WIDTH
+#define CKSUM_FOLD_WIDTH 4
+#endif
+
+/* BarrettReduce, kept in vector registers.  The generic form moves every
+   product between vector and general registers, which would dominate the
+   latency of short buffers.  */
+static CrcType Reduce(uint128_t u) noexcept {
+  using C = tjg::crc::Crc32Consts;
+#if TJG_SIMD_BUILTIN == TJG_SIMD_SSE
+  static_assert(C::Bits == 32);
+  const auto KA = _mm_set_epi64x(C::XpowMod(64), C::XpowMod(96));
+  const auto KB = _mm_set_epi64x(C::Poly, C::Mu2N & C::Mask);
+  auto v = std::bit_cast<__m128i>(u);
+  auto s = _mm_clmulepi64_si128(v, KA, 0x01)
+         ^ _mm_slli_si128(_mm_move_epi64(v), 4);
+  s = _mm_clmulepi64_si128(s, KA, 0x11) ^ _mm_move_epi64(s);
+  auto t = _mm_srli_epi64(s, 32);
+  auto q = t ^ _mm_srli_epi64(_mm_clmulepi64_si128(t, KB, 0x00), 32);
+  return CrcType(_mm_cvtsi128_si32(s ^ _mm_clmulepi64_si128(q, KB, 0x10)));
+#else
+  return CrcType(tjg::crc::BarrettReduce<C>(u, simd::clmul));
+#endif
+} // Reduce
+
+/* Shorter buffers take the table: a lone block must hold the register, and
+   with the table in cache a few lookups beat a reduction up to about 6 bytes.
+   Raise it where the table stays hot.  */
+#ifndef CKSUM_SHORT_MIN
+#define CKSUM_SHORT_MIN 4
+#endif
+static_assert(CKSUM_SHORT_MIN >= 4, "A lone block must hold the register.");
+
+/* When size is not a multiple of 16, its first size % 16 bytes form a short
+   first block with the register mixed in, folded onto the next.  Every later
+   block is whole, so there is no byte loop for alignment or for a tail, and
+   a single reduction.  */
+template<std::size_t N>
+CrcType cksum_simd_n(CrcType crc, const void* buf, std::size_t size) noexcept {
   using Vec = simd::Simd<simd::uint64x2_t>;
   using C = tjg::crc::Crc32Consts;
+  if (size < CKSUM_SHORT_MIN)
+    return CrcUpdate(crc, buf, size);
+  auto bp = reinterpret_cast<const std::byte*>(buf);
+  if (size <= sizeof(U128)) {
+    auto acc = tjg::crc::StartFold<C>(crc, bp, size).acc;
+    return Reduce(acc);
+  }
+  auto u = uint128_t{crc} << (128-32);
+  if (auto head = size % sizeof(U128); head != 0) {
+    auto [acc, next] = tjg::crc::StartFold<C>(crc, bp, head);
+    static const auto SingleK = Vec{C::FoldK_lo<1>, C::FoldK_hi<1>};
+    u = uint128_t{ClMulDiag(Vec{acc}, SingleK)} ^ next;
+    bp   += head;
+    size -= head;
+  }
+  u = tjg::crc::FoldBlocks<tjg::crc::Crc32Cksum, N>(u, bp,
+                                                     size / sizeof(U128));
+  return Reduce(u);
+} // cksum_simd_n
 
-  static const auto SingleK = Vec{C::K128_lo, C::K128_hi};
-  static const auto FourK   = Vec{C::K512_lo, C::K512_hi};
+CrcType cksum_simd(CrcType crc, const void* buf, std::size_t size) noexcept
+  { return cksum_simd_n<CKSUM_FOLD_WIDTH>(crc, buf, size); }
 
-  auto Load   = [](U128 x) -> Vec  { return  Vec{x}; };
+CrcType cksum_simd2(CrcType crc, const void* buf, std::size_t size) noexcept
+  { return cksum_simd_n<2>(crc, buf, size); }
 
-  auto data0 = Vec{init} ^ Load(buf[0]);
+CrcType cksum_simd8(CrcType crc, const void* buf, std::size_t size) noexcept
+  { return cksum_simd_n<8>(crc, buf, size); }
 
-  if (num >= 8) {
-    auto data1 = Load(buf[1]);
-    auto data2 = Load(buf[2]);
-    auto data3 = Load(buf[3]);
+CrcType cksum_simd16(CrcType crc, const void* buf, std::size_t size) noexcept
+  { return cksum_simd_n<16>(crc, buf, size); }
 
-    for ( ; num >= 8; num -= 4) {
-      buf += 4;
-      data0 = ClMulDiag(data0, FourK) ^ Load(buf[0]);
-      data1 = ClMulDiag(data1, FourK) ^ Load(buf[1]);
-      data2 = ClMulDiag(data2, FourK) ^ Load(buf[2]);
-      data3 = ClMulDiag(data3, FourK) ^ Load(buf[3]);
-    }
+/* Number of independent buffers cksum_batch folds side by side, one per
+   accumulator, so their clmul chains overlap like the accumulators of
+   cksum_simd.  */
+#ifndef CKSUM_BATCH_WIDTH
+#define CKSUM_BATCH_WIDTH 4
+#endif
+
+/* Longer buffers go to the single-buffer kernel, whose wide fold beats one
+   accumulator per buffer once there are enough blocks to fill it.  */
+#ifndef CKSUM_BATCH_MAX
+#define CKSUM_BATCH_MAX 384
+#endif
+
+/* Each buffer is a stream of 16-byte blocks folded into its own accumulator:
+   its short head block, or its first block, with the register mixed in; the
+   block that one folds into; then the rest of the buffer in place.  The
+   first one or two are staged big-endian like the data.  Within a group the
+   streams are right-aligned, so a buffer with fewer blocks starts later,
+   behind zero blocks that leave its accumulator at zero, and every buffer
+   needs only one reduction however ragged the lengths.  */
+template<std::size_t R>
+void cksum_batch_n(std::span<const CrcBuffer> bufs, std::span<CrcType> crcs)
+{
+  using Vec = simd::Simd<simd::uint64x2_t>;
+  using C = tjg::crc::Crc32Consts;
+  constexpr auto Block = sizeof(U128);
+  static const auto SingleK = Vec{C::FoldK_lo<1>, C::FoldK_hi<1>};
+  alignas(U128) static constexpr std::array<std::byte, Block> Zero{};
+
+  auto LoadBlock = [](const std::byte* p) {
+    auto x = U128{};
+    std::memcpy(&x, p, sizeof(x));
+    return uint128_t{x};
+  };
 
-    data0 = ClMulDiag(data0, SingleK) ^ data1;
-    data0 = ClMulDiag(data0, SingleK) ^ data2;
-    data0 = ClMulDiag(data0, SingleK) ^ data3;
-    num -= 3;
-    buf += 3;
+  // Short buffers take the table in one pass, so a batch of nothing else
+  // costs no more than a loop over them.
+  auto grouped = false;
+  for (std::size_t i = 0; i != bufs.size(); ++i) {
+    if (bufs[i].size() < CKSUM_SHORT_MIN)
+      crcs[i] = CrcUpdate(crcs[i], bufs[i].data(), bufs[i].size());
+    else
+      grouped = true;
   }
-  for ( ; num >= 2; --num)
-    data0 = ClMulDiag(data0, SingleK) ^ Load(*++buf);
-  return uint128_t{data0};
-} // do_cksum_simd
+  if (!grouped)
+    return;
 
-CrcType cksum_simd(CrcType crc, const void* buf, std::size_t size) noexcept {
-  if (size < 2 * sizeof(U128))
-    return CrcUpdate(crc, buf, size);
-  auto bp = reinterpret_cast<const std::byte*>(buf);
-  {
-    auto head =
-        std::size_t{reinterpret_cast<std::uintptr_t>(bp) % alignof(uint128_t)};
-    if (head != 0) [[unlikely]] {
-      head  = alignof(uint128_t) - head;
-      crc   = CrcUpdate(crc, bp, head);
-      bp   += head;
-      size -= head;
+  auto cksum_fp = CksumKernel();
+  for (std::size_t first = 0; first < bufs.size(); first += R) {
+    auto count = std::min(R, bufs.size() - first);
+    std::array<std::array<U128, 2>, R> stage;
+    auto base   = std::array<const std::byte*, R>{};
+    auto staged = std::array<std::size_t, R>{};
+    auto blocks = std::array<std::size_t, R>{};
+    auto steps  = std::size_t{0};
+    for (std::size_t j = 0; j != count; ++j) {
+      auto p   = bufs[first+j].data();
+      auto n   = bufs[first+j].size();
+      auto crc = crcs[first+j];
+      if (n < CKSUM_SHORT_MIN)
+        continue;
+      if (n > CKSUM_BATCH_MAX) {
+        crcs[first+j] = cksum_fp(crc, p, n);
+        continue;
+      }
+      if (n <= Block) {
+        stage[j][0] = U128{tjg::crc::StartFold<C>(crc, p, n).acc};
+        staged[j] = blocks[j] = 1;
+      }
+      else if (auto head = n % Block; head == 0) {
+        stage[j][0] = U128{LoadBlock(p) ^ (uint128_t{crc} << (128-32))};
+        staged[j] = 1;
+        base[j]   = p + Block;
+        blocks[j] = n / Block;
+      }
+      else {
+        auto [acc, next] = tjg::crc::StartFold<C>(crc, p, head);
+        stage[j][0] = U128{acc};
+        stage[j][1] = U128{LoadBlock(p + head) ^ next};
+        staged[j] = 2;
+        base[j]   = p + head + Block;
+        blocks[j] = 1 + n / Block;
+      }
+      steps = std::max(steps, blocks[j]);
+    }
+
+    auto block = [&](std::size_t j, std::size_t k) -> const std::byte* {
+      auto lead = steps - blocks[j];
+      if (k < lead)
+        return Zero.data();
+      k -= lead;
+      if (k < staged[j])
+        return reinterpret_cast<const std::byte*>(&stage[j][k]);
+      return base[j] + (k - staged[j]) * Block;
+    };
+    auto acc = std::array<Vec, R>{};
+    for (std::size_t k = 0; k != steps; ++k) {
+      [&]<std::size_t... Js>(std::index_sequence<Js...>) {
+        ((acc[Js] = ClMulDiag(acc[Js], SingleK)
+                  ^ Vec{U128{LoadBlock(block(Js, k))}}), ...);
+      }(std::make_index_sequence<R>{});
+    }
+    for (std::size_t j = 0; j != count; ++j) {
+      if (blocks[j] != 0)
+        crcs[first+j] = Reduce(uint128_t{acc[j]});
     }
   }
-  auto ap = std::assume_aligned<alignof(uint128_t)>(bp);
-  auto p  = reinterpret_cast<const U128*>(ap);
-  auto n  = size / sizeof(U128);
-  auto r  = size % sizeof(U128);
-  auto u  = do_cksum_simd(uint128_t{crc} << (128-32), p, n);
-  crc = CrcType{0};
-  for (std::size_t i = 0; i != sizeof(u); ++i)
-    crc = CrcUpdate(crc, std::byte(u >> 8*((sizeof(u)-1)-i)));
-  return CrcUpdate(crc, p+n, r);
-} // cksum_simd
+} // cksum_batch_n
+
+void cksum_batch(std::span<const CrcBuffer> bufs, std::span<CrcType> crcs)
+  { cksum_batch_n<CKSUM_BATCH_WIDTH>(bufs, crcs); }
@@ -1,6 +1,8 @@
 #include "cksum.hpp"
 #include "CrcUpdate.hpp"
+#include "CrcBarrett.hpp"
 #include <bit>
+#include <cstddef>
 #include <arm_neon.h>
 #include <cstdint>
 
@@ -22,10 +24,8 @@ uint128_t do_cksum_vmull0(std::uint32_t crc, const uint128_t* buf, std::size_t n
     return bswap_neon(v);
   };
 
-  auto Unload = [](uint64x2_t v) -> uint128_t {
-    v = bswap_neon(v);
-    return std::bit_cast<uint128_t>(v);
-  };
+  auto Unload = [](uint64x2_t v) -> uint128_t
+    { return std::bit_cast<uint128_t>(v); };
 
   auto ClMulDiag = [](uint64x2_t x, poly64x2_t k) {
     auto t = vreinterpretq_u64_p128(
@@ -81,13 +81,25 @@ uint128_t do_cksum_vmull0(std::uint32_t crc, const uint128_t* buf, std::size_t n
 } // do_cksum_vmull0
 
 CrcType cksum_vmull0(CrcType crc, const void* buf, std::size_t size) noexcept {
+  // vld1q itself takes any address, but the buffer is walked as uint128_t,
+  // which needs 16-byte alignment; byte-step to the first aligned block, as
+  // cksum_pclmul0 does.
+  auto head = reinterpret_cast<std::uintptr_t>(buf) % alignof(uint128_t);
+  if (head != 0 && size >= 2 * sizeof(uint128_t)) [[unlikely]] {
+    head  = alignof(uint128_t) - head;
+    crc   = CrcUpdate(crc, buf, head);
+    buf   = static_cast<const std::byte*>(buf) + head;
+    size -= head;
+  }
   auto n = size / sizeof(uint128_t);
   auto r = size % sizeof(uint128_t);
   if (n < 2)
     return CrcUpdate(crc, buf, size);
   auto p = reinterpret_cast<const uint128_t*>(buf);
   auto u = do_cksum_vmull0(crc, p, n);
-  crc = CrcUpdate(CrcType{0}, &u, sizeof(u));
+  auto clmul = [](std::uint64_t x, std::uint64_t y) -> uint128_t
+    { return uint128_t(vmull_p64(x, y)); };
+  crc = CrcType(tjg::crc::BarrettReduce<tjg::crc::Crc32Consts>(u, clmul));
   crc = CrcUpdate(crc, p+n, r);
   return crc;
 } // cksum_vmull0
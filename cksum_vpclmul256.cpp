@@ -0,0 +1,20 @@
+#include "cksum.hpp"
+#include "CrcConsts.hpp"
+#include "CrcUpdate.hpp"
+
+#define TJG_SIMD_ISA 2
+#include "Simd.hpp"
+#include "CrcWide.hpp"
+
+/* Without VPCLMULQDQ in the target, fall back to the 128-bit kernel so callers
+   always link.  */
+
+CrcType cksum_vpclmul256(CrcType crc, const void* buf, std::size_t size)
+  noexcept
+{
+#if TJG_SIMD_WIDE >= 256
+  return cksum_wide<simd::uint64x4_t>(crc, buf, size);
+#else
+  return cksum_simd(crc, buf, size);
+#endif
+} // cksum_vpclmul256
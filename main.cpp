@@ -2,52 +2,509 @@
 #include "CrcUpdate.hpp"
 
 #include <string_view>
+#include <charconv>
+#include <chrono>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <optional>
+#include <utility>
 #include <cstdint>
 #include <cstdlib>
 
+#include <sys/resource.h>
+
+static bool ParseCount(std::string_view s, unsigned* n) {
+  auto [p, ec] = std::from_chars(s.data(), s.data() + s.size(), *n);
+  return (ec == std::errc{} && p == s.data() + s.size() && *n != 0);
+} // ParseCount
+
+/// A nonzero byte count with an optional binary K, M or G suffix.
+static bool ParseSize(std::string_view s, std::uintmax_t* n) {
+  auto [p, ec] = std::from_chars(s.data(), s.data() + s.size(), *n);
+  if (ec != std::errc{} || *n == 0)
+    return false;
+  auto rest = std::string_view{p, s.data() + s.size()};
+  if (rest.empty())
+    return true;
+  auto shift = std::string_view{"KMG"}.find(rest);
+  if (rest.size() != 1 || shift == std::string_view::npos)
+    return false;
+  *n <<= 10 * (shift + 1);
+  return true;
+} // ParseSize
+
+/// One line of cksum output, "CRC LENGTH NAME".
+static bool ParseLine(std::string_view s, SumResult* r, std::string_view* name)
+{
+  auto field = [&](auto* n) {
+    auto [p, ec] = std::from_chars(s.data(), s.data() + s.size(), *n);
+    if (ec != std::errc{} || p == s.data() + s.size() || *p != ' ')
+      return false;
+    s.remove_prefix(static_cast<std::size_t>(p + 1 - s.data()));
+    return true;
+  };
+  if (!field(&r->crc) || !field(&r->length) || s.empty() || r->length < 0)
+    return false;
+  *name = s;
+  return true;
+} // ParseLine
+
+/// Earlier cksum output, every line of which must parse.
+static bool ReadListing(const std::filesystem::path& fname, SumTable* table) {
+  auto in = std::ifstream{fname};
+  if (!in)
+    return false;
+  auto line = std::string{};
+  while (std::getline(in, line)) {
+    auto r = SumResult{};
+    auto name = std::string_view{};
+    if (!ParseLine(line, &r, &name))
+      return false;
+    (*table)[std::string{name}] = r;
+  }
+  return in.eof();
+} // ReadListing
+
+/// s as a JSON string literal.
+static std::string JsonString(std::string_view s) {
+  constexpr auto Hex = std::string_view{"0123456789abcdef"};
+  auto out = std::string{'"'};
+  for (auto c: s) {
+    auto u = static_cast<unsigned char>(c);
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    }
+    else if (u < 0x20) {
+      out += "\\u00";
+      out += Hex[u >> 4];
+      out += Hex[u & 0xf];
+    }
+    else {
+      out += c;
+    }
+  }
+  out += '"';
+  return out;
+} // JsonString
+
+/* The --stats report, one JSON object with a record per file as it was
+   reported and a total for the run.  The total's wall, user and system
+   times are the process's, over all threads; its blocked and crc times are
+   the files' summed, so with -j they are thread-seconds.  */
+class StatsReport {
+public:
+  StatsReport() noexcept : _start{Clock::now()}, _cpu{Cpu()} { }
+
+  void add(const std::string& name, const SumResult& r) {
+    auto out = std::ostringstream{};
+    out << "    {\"name\": " << JsonString(name);
+    if (!r.error.empty()) {
+      out << ", \"error\": " << JsonString(r.error) << '}';
+      _files.push_back(out.str());
+      return;
+    }
+    const auto& s = r.stats;
+    auto bytes = static_cast<std::uintmax_t>(r.length);
+    Times(out, bytes, s.wall, s.blocked, s.user, s.system, s.crc);
+    out << '}';
+    _files.push_back(out.str());
+    _bytes   += bytes;
+    _blocked += s.blocked;
+    _crc     += s.crc;
+  }
+
+  void write(std::ostream& out) const {
+    auto cpu = Cpu();
+    auto wall = std::chrono::duration<double>{Clock::now() - _start}.count();
+    out << "{\n  \"kernel\": " << JsonString(CksumKernelInfo().name)
+        << ",\n  \"files\": [";
+    auto sep = "\n";
+    for (const auto& f: _files) {
+      out << sep << f;
+      sep = ",\n";
+    }
+    out << "\n  ],\n  \"total\": {\"files\": " << _files.size();
+    Times(out, _bytes, wall, _blocked, cpu.first - _cpu.first,
+          cpu.second - _cpu.second, _crc);
+    out << "}\n}\n";
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point _start;
+  std::pair<double, double> _cpu;   // user, system seconds at start
+  std::vector<std::string> _files;
+  std::uintmax_t _bytes = 0;
+  double _blocked = 0;
+  double _crc = 0;
+
+  static std::pair<double, double> Cpu() noexcept {
+    auto secs = [](const timeval& tv)
+      { return double(tv.tv_sec) + 1e-6 * double(tv.tv_usec); };
+    struct rusage ru;
+    if (::getrusage(RUSAGE_SELF, &ru) != 0)
+      return {0, 0};
+    return {secs(ru.ru_utime), secs(ru.ru_stime)};
+  }
+
+  static void Times(std::ostream& out, std::uintmax_t bytes, double wall,
+                    double blocked, double user, double system, double crc)
+  {
+    auto rate = (wall > 0) ? double(bytes) / wall / double(1 << 30) : 0.0;
+    out << ", \"bytes\": " << bytes << std::fixed << std::setprecision(6)
+        << ", \"wall_s\": " << wall << ", \"blocked_s\": " << blocked
+        << ", \"user_s\": " << user << ", \"system_s\": " << system
+        << ", \"crc_s\": " << crc << std::setprecision(3)
+        << ", \"gib_per_s\": " << rate;
+  }
+}; // StatsReport
+
+/// How much --check prints besides its exit status.
+enum class Verbosity { Status, Quiet, All };
+
+static void Warn(std::size_t n, const char* one, const char* many) {
+  if (n != 0)
+    std::cerr << "cksum: WARNING: " << n << ' ' << ((n == 1) ? one : many)
+              << '\n';
+}
+
+/* Verify every file of one list, printing "NAME: OK" or "NAME: FAILED" and
+   warning about the rest on stderr as coreutils does.  Lines that do not
+   parse are counted and skipped.  Fails if any file fails or cannot be read,
+   or if the list has no usable line.  */
+
+static bool Check(const std::filesystem::path& list, const SumOptions& opts,
+                  unsigned jobs, bool ordered, Verbosity verbosity,
+                  StatsReport* stats)
+{
+  auto file = std::ifstream{};
+  std::istream* in = &std::cin;
+  if (list != "-") {
+    file.open(list);
+    if (!file) {
+      std::cerr << "cksum: " << list.generic_string() << ": cannot read\n";
+      return false;
+    }
+    in = &file;
+  }
+  auto entries = std::vector<CheckEntry>{};
+  auto malformed = std::size_t{0};
+  auto line = std::string{};
+  while (std::getline(*in, line)) {
+    auto r = SumResult{};
+    auto name = std::string_view{};
+    if (!ParseLine(line, &r, &name)) {
+      ++malformed;
+      continue;
+    }
+    entries.push_back(CheckEntry{std::filesystem::path{name}, r.crc, r.length});
+  }
+  if (entries.empty()) {
+    std::cerr << "cksum: " << list.generic_string()
+              << ": no properly formatted checksum lines found\n";
+    return false;
+  }
+
+  std::size_t failed = 0, unreadable = 0;
+  CrcCheckFiles(entries, opts, jobs, ordered,
+    [&](std::size_t i, const SumResult& r) {
+      const auto& e = entries[i];
+      auto name = e.name.generic_string();
+      if (stats)
+        stats->add(name, r);
+      if (!r.error.empty()) {
+        ++unreadable;
+        std::cerr << "cksum: " << name << ": " << r.error << '\n';
+        if (verbosity != Verbosity::Status)
+          std::cout << name << ": FAILED open or read\n";
+        return;
+      }
+      bool ok = (r.crc == e.crc && r.length == e.length);
+      failed += !ok;
+      if (ok ? (verbosity == Verbosity::All) : (verbosity != Verbosity::Status))
+        std::cout << name << (ok ? ": OK\n" : ": FAILED\n");
+    });
+  if (verbosity != Verbosity::Status) {
+    Warn(malformed,  "line is improperly formatted",
+                     "lines are improperly formatted");
+    Warn(unreadable, "listed file could not be read",
+                     "listed files could not be read");
+    Warn(failed,     "computed checksum did NOT match",
+                     "computed checksums did NOT match");
+  }
+  return (failed == 0 && unreadable == 0);
+} // Check
+
+static int Usage() {
+  std::cerr << "usage: cksum [-j N] [--unordered] [--threads=N] [--mmap]"
+               " [--populate] [--uring] [--direct] [--queue-depth=N]"
+               " [--kernel=NAME] [--cache] [--cache-refresh] [--cache-verify=N]"
+               " [--resume=LIST] [--manifest=FILE] [--manifest-binary]"
+               " [--block-size=N] [--stats[=FILE]] [--numa] file...\n"
+               "       cksum --follow [--resume=LIST] file\n"
+               "       cksum -c [--quiet|--status] [--io-budget=N] [-j N]"
+               " [--stats[=FILE]] list...\n"
+               "       cksum --list-kernels\n";
+  return EXIT_FAILURE;
+} // Usage
+
 int main(int argc, const char* argv[]) {
   using namespace std::literals;
   namespace fs = std::filesystem;
-  if (argc < 2) {
-    std::cerr << "usage: cksum file...\n";
+  auto opts = SumOptions{};
+  auto jobs = 1u;
+  auto ordered = true;
+  auto follow = false;
+  auto prior = SumTable{};
+  auto manifest_name = std::string{};
+  auto manifest_binary = false;
+  auto block = std::uintmax_t{1} << 20;
+  auto check = false;
+  auto verbosity = Verbosity::All;
+  auto stats_name = std::string{};   // "-" for stderr
+  int first = 1;
+  for ( ; first != argc; ++first) {
+    auto arg = std::string_view{argv[first]};
+    if (arg == "--"sv) {
+      ++first;
+      break;
+    }
+    if (!arg.starts_with("-"sv) || arg == "-"sv)
+      break;
+    if (arg == "--version"sv) {
+      std::cout << "cksum (coreutils-9.7)\n";
+      return EXIT_SUCCESS;
+    }
+    else if (arg == "-j"sv) {
+      if (++first == argc || !ParseCount(argv[first], &jobs))
+        return Usage();
+    }
+    else if (arg.starts_with("-j"sv)) {
+      if (!ParseCount(arg.substr(2), &jobs))
+        return Usage();
+    }
+    else if (arg.starts_with("--jobs="sv)) {
+      if (!ParseCount(arg.substr(7), &jobs))
+        return Usage();
+    }
+    else if (arg == "--unordered"sv) {
+      ordered = false;
+    }
+    else if (arg.starts_with("--kernel="sv)) {
+      if (!CksumSelect(arg.substr(9))) {
+        std::cerr << arg.substr(9) << ": unknown or unsupported kernel\n";
+        return EXIT_FAILURE;
+      }
+    }
+    else if (arg == "--list-kernels"sv) {
+      const auto& active = CksumKernelInfo();
+      for (const auto& k: CksumKernels()) {
+        std::cout << k.name << (k.supported() ? "" : " (unsupported)")
+                  << (&k == &active ? " *" : "") << '\n';
+      }
+      return EXIT_SUCCESS;
+    }
+    else if (arg.starts_with("--threads="sv)) {
+      if (!ParseCount(arg.substr(10), &opts.threads))
+        return Usage();
+    }
+    else if (arg == "--mmap"sv) {
+      opts.reader = Reader::Mmap;
+    }
+    else if (arg == "--populate"sv) {
+      opts.reader = Reader::Mmap;
+      opts.populate = true;
+    }
+    else if (arg == "--uring"sv) {
+      opts.reader = Reader::Uring;
+    }
+    else if (arg == "--direct"sv) {
+      opts.reader = Reader::Direct;
+    }
+    else if (arg.starts_with("--queue-depth="sv)) {
+      if (!ParseCount(arg.substr(14), &opts.depth))
+        return Usage();
+    }
+    else if (arg == "--cache"sv) {
+      opts.cache = Cache::Use;
+    }
+    else if (arg == "--cache-refresh"sv) {
+      opts.cache = Cache::Refresh;
+    }
+    else if (arg.starts_with("--cache-verify="sv)) {
+      if (!ParseCount(arg.substr(15), &opts.verify))
+        return Usage();
+      if (opts.cache == Cache::Off)
+        opts.cache = Cache::Use;
+    }
+    else if (arg.starts_with("--resume="sv)) {
+      if (!ReadListing(fs::path{arg.substr(9)}, &prior)) {
+        std::cerr << arg.substr(9) << ": cannot read cksum listing\n";
+        return EXIT_FAILURE;
+      }
+      opts.prior = &prior;
+    }
+    else if (arg == "--follow"sv) {
+      follow = true;
+    }
+    else if (arg.starts_with("--manifest="sv)) {
+      manifest_name = arg.substr(11);
+    }
+    else if (arg == "--manifest-binary"sv) {
+      manifest_binary = true;
+    }
+    else if (arg == "-c"sv || arg == "--check"sv) {
+      check = true;
+    }
+    else if (arg == "--quiet"sv) {
+      verbosity = Verbosity::Quiet;
+    }
+    else if (arg == "--status"sv) {
+      verbosity = Verbosity::Status;
+    }
+    else if (arg.starts_with("--io-budget="sv)) {
+      if (!ParseCount(arg.substr(12), &opts.budget))
+        return Usage();
+    }
+    else if (arg.starts_with("--block-size="sv)) {
+      if (!ParseSize(arg.substr(13), &block))
+        return Usage();
+    }
+    else if (arg == "--numa"sv) {
+      opts.numa = true;
+    }
+    else if (arg == "--stats"sv) {
+      stats_name = "-";
+    }
+    else if (arg.starts_with("--stats="sv)) {
+      stats_name = arg.substr(8);
+      if (stats_name.empty())
+        return Usage();
+    }
+    else {
+      return Usage();
+    }
+  }
+  if (first == argc)
+    return Usage();
+  if (opts.threads > 1 && opts.reader != Reader::Stream) {
+    std::cerr << "--threads reads each range as a stream; it cannot be"
+                 " combined with --mmap, --populate, --uring or --direct\n";
+    return EXIT_FAILURE;
+  }
+  if (!stats_name.empty() && follow) {
+    std::cerr << "--stats reports on files summed once; it cannot be"
+                 " combined with --follow\n";
     return EXIT_FAILURE;
   }
-  if (std::string_view{argv[1]} == "--version"sv) {
-    std::cout << "cksum (coreutils-9.7)\n";
+  if (manifest_binary && manifest_name.empty()) {
+    std::cerr << "--manifest-binary needs --manifest\n";
+    return EXIT_FAILURE;
+  }
+  if (!manifest_name.empty() && (check || follow)) {
+    std::cerr << "--manifest writes the block CRCs of files summed once; it"
+                 " cannot be combined\nwith --check or --follow\n";
+    return EXIT_FAILURE;
+  }
+  auto files = std::vector<fs::path>(argv + first, argv + argc);
+  auto stats = std::optional<StatsReport>{};
+  if (!stats_name.empty()) {
+    CksumTimeKernel();
+    opts.stats = true;
+    stats.emplace();
+  }
+  // Written after the last file has been reported.
+  auto write_stats = [&]() {
+    if (!stats)
+      return true;
+    if (stats_name == "-") {
+      stats->write(std::cerr);
+      return true;
+    }
+    auto out = std::ofstream{stats_name};
+    stats->write(out);
+    out.close();
+    if (!out)
+      std::cerr << stats_name << ": cannot write statistics\n";
+    return bool(out);
+  };
+  auto stats_ptr = stats ? &*stats : nullptr;
+  if (check) {
+    bool ok = true;
+    for (const auto& list: files)
+      ok &= Check(list, opts, jobs, ordered, verbosity, stats_ptr);
+    ok &= write_stats();
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  auto print = [](const fs::path& fname, const SumResult& r) {
+    std::cout << r.crc << ' ' << r.length
+              << ' ' << fname.generic_string() << '\n';
+  };
+  if (follow) {
+    if (files.size() != 1)
+      return Usage();
+    const auto& fname = files.front();
+    auto it = prior.find(fname.generic_string());
+    auto start = (it != prior.end()) ? &it->second : nullptr;
+    try {
+      CrcFollow(fname, start, [&](const SumResult& r) {
+        print(fname, r);
+        std::cout.flush();
+      });
+    }
+    catch (const std::exception& x) {
+      std::cerr << fname.generic_string() << ": " << x.what() << '\n';
+      return EXIT_FAILURE;
+    }
     return EXIT_SUCCESS;
   }
-#if 0
-  {
-    using namespace std;
-    cout << setfill('0') << hex;
-    for (int i = 0; i != 8; ++i) {
-      cout << "{";
-      for (int j = 0; j != 256; ++j) {
-        if (j % 8 == 0)
-          cout << "\n ";
-        cout << " 0x";
-        cout << setw(8) << std::byteswap(CrcTab[i][j]) << ',';
-      }
-      cout << "\n}";
+  auto manifest = std::ofstream{};
+  if (!manifest_name.empty()) {
+    // Block CRCs come from the stream reader's single pass over each file.
+    if (opts.reader != Reader::Stream || opts.threads > 1
+        || opts.cache != Cache::Off || opts.prior)
+    {
+      std::cerr << "--manifest reads every file as a stream; it cannot be"
+                   " combined with --mmap, --uring,\n--direct, --threads,"
+                   " --cache or --resume\n";
+      return EXIT_FAILURE;
+    }
+    auto mode = std::ios::out | std::ios::trunc;
+    if (manifest_binary)
+      mode |= std::ios::binary;
+    manifest.open(manifest_name, mode);
+    if (!manifest) {
+      std::cerr << manifest_name << ": cannot write manifest\n";
+      return EXIT_FAILURE;
     }
-    cout << setfill(' ') << dec;
+    opts.block = block;
   }
-#endif
-  for (int i = 1; i != argc; ++i) {
-    auto fname = fs::path{argv[i]};
-    auto fp = std::ifstream{fname, std::ios::in | std::ios::binary};
-    if (!fp) {
-      std::cerr << fname.generic_string() << ": cannot read\n";
-      continue;
+  CrcSumFiles(files, opts, jobs, ordered,
+    [&](std::size_t i, const SumResult& r) {
+      const auto& fname = files[i];
+      if (stats)
+        stats->add(fname.generic_string(), r);
+      if (!r.error.empty()) {
+        std::cerr << fname.generic_string() << ": " << r.error << '\n';
+        return;
+      }
+      print(fname, r);
+      if (manifest.is_open())
+        WriteManifest(manifest, fname.generic_string(), r, manifest_binary);
+    });
+  if (manifest.is_open()) {
+    manifest.close();
+    if (!manifest) {
+      std::cerr << manifest_name << ": error writing manifest\n";
+      return EXIT_FAILURE;
     }
-    auto file_length = std::streamsize{0};
-    auto crc_result = CrcSumStream(fp, &file_length);
-    std::cout << crc_result << ' ' << file_length
-              << ' ' << fname.generic_string() << '\n';
-    fp.close();
   }
-  return EXIT_SUCCESS;
+  return write_stats() ? EXIT_SUCCESS : EXIT_FAILURE;
 } // main